@@ -0,0 +1,135 @@
+#ifndef AUTOTUNE_HPP
+#define AUTOTUNE_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Gemm.hpp"
+#include "Matrix.hpp"
+#include "RandomMatrix.hpp"
+#include "Simd.hpp"
+#include "Strassen.hpp"
+#include "Tuning.hpp"
+#include "Workspace.hpp"
+
+// Autotuning en la máquina actual (un solo hilo, el kernel SIMD en uso):
+//  1. Bloques de GEMM: prueba combinaciones de MC/KC/NC y se queda con la más rápida.
+//  2. Umbral de Strassen: para cada N compara el motor por bloques contra UN
+//     nivel de Strassen (hijos N/2 resueltos con el motor). El umbral es el
+//     mayor N en el que el motor aún gana antes de que Strassen gane siempre.
+// El resultado se guarda en el archivo de tuning que se lee al arrancar.
+
+struct AutotuneResult {
+    int strassenThreshold;
+    GemmBlocking blocking;
+};
+
+// Mejor tiempo (ms) de reps ejecuciones tras un calentamiento
+template <typename F>
+double bestTimeMs(F&& run, int reps) {
+    run();
+    double best = 1e300;
+    for (int r = 0; r < reps; r++) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+// Matriz n x n de enteros 0-9 con semilla fija (flujo stream, RandomMatrix.hpp)
+inline Matrix<int> autotuneRandomMatrix(int n, uint32_t stream) {
+    Matrix<int> m(n, n);
+    fillRandomMatrix<int>(m.view(), 42, stream);
+    return m;
+}
+
+inline GemmBlocking autotuneBlocking(int n, std::ostream& log) {
+    Matrix<int> A = autotuneRandomMatrix(n, 0), B = autotuneRandomMatrix(n, 1), C(n, n);
+
+    GemmBlocking best = gemmBlocking();
+    double bestMs = 1e300;
+    log << "Bloques de GEMM (N = " << n << "):\n";
+    for (int mc : {48, 96, 144, 192}) {
+        for (int kc : {128, 256, 384, 512}) {
+            for (int nc : {1024, 4096}) {
+                setGemmBlocking({mc, kc, nc});
+                double ms = bestTimeMs([&] { gemm<int, int>(A, B, C); }, 3);
+                log << "  MC=" << gemmBlocking().mc << " KC=" << kc << " NC=" << nc << ": " << ms << " ms\n";
+                if (ms < bestMs) {
+                    bestMs = ms;
+                    best = gemmBlocking();
+                }
+            }
+        }
+    }
+    setGemmBlocking(best);
+    return best;
+}
+
+inline int autotuneStrassenThreshold(int maxSize, std::ostream& log) {
+    std::vector<int> sizes;
+    for (int n : {32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096}) {
+        if (n <= maxSize) sizes.push_back(n);
+    }
+
+    int savedThreshold = strassenThreshold();
+    StrassenParallelConfig savedParallel = strassenParallelConfig();
+    strassenParallelConfig().parallelDepth = 0; // Comparación por núcleo
+
+    std::vector<bool> strassenWins;
+    log << "Motor por bloques vs un nivel de Strassen:\n";
+    log << "  N\tbloques (ms)\tStrassen (ms)\n";
+    for (int n : sizes) {
+        Matrix<int> A = autotuneRandomMatrix(n, 0), B = autotuneRandomMatrix(n, 1), C(n, n);
+        int reps = n <= 256 ? 10 : 3;
+        double baseMs = bestTimeMs([&] { gemm<int, int>(A, B, C); }, reps);
+
+        strassenThreshold() = n - 1; // Un solo nivel: los hijos N/2 van al motor
+        Workspace ws(strassen_workspace_size(n));
+        double levelMs = bestTimeMs([&] { strassen_multiply<int, int>(A, B, C, ws); }, reps);
+
+        log << "  " << n << "\t" << baseMs << "\t\t" << levelMs << "\n";
+        strassenWins.push_back(levelMs < baseMs);
+    }
+
+    strassenThreshold() = savedThreshold;
+    strassenParallelConfig() = savedParallel;
+
+    // Primer tamaño desde el que Strassen gana en todos los siguientes
+    size_t first = sizes.size();
+    while (first > 0 && strassenWins[first - 1]) first--;
+    if (first == sizes.size()) return sizes.back(); // Nunca gana: no recurrir en lo medido
+    if (first == 0) return sizes.front() / 2;
+    return sizes[first - 1];
+}
+
+// Ejecuta el autotuning, aplica los valores y los guarda en el archivo de tuning
+inline AutotuneResult autotune(int maxSize, std::ostream& log) {
+    log << "Autotuning (kernel SIMD: " << simdIsaName(simdKernels().isa) << ")\n";
+    AutotuneResult result;
+    result.blocking = autotuneBlocking(std::min(maxSize, 512), log);
+    result.strassenThreshold = autotuneStrassenThreshold(maxSize, log);
+    strassenThreshold() = result.strassenThreshold;
+
+    std::string path = tuningFilePath();
+    std::map<std::string, std::string> values = {
+        {"strassen_threshold", std::to_string(result.strassenThreshold)},
+        {"gemm_mc", std::to_string(result.blocking.mc)},
+        {"gemm_kc", std::to_string(result.blocking.kc)},
+        {"gemm_nc", std::to_string(result.blocking.nc)},
+    };
+    bool saved = updateTuningFile(path, values);
+
+    log << "Valores elegidos:\n";
+    for (const auto& kv : values) log << "  " << kv.first << "=" << kv.second << "\n";
+    log << (saved ? "Guardados en " : "No se pudieron guardar en ") << path << "\n";
+    return result;
+}
+
+#endif
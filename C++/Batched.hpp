@@ -0,0 +1,162 @@
+#ifndef BATCHED_HPP
+#define BATCHED_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "Gemm.hpp"
+#include "Matrix.hpp"
+#include "SmallGemm.hpp"
+#include "ThreadPool.hpp"
+
+// Multiplicación por lotes de muchas matrices pequeñas independientes
+// (C[b] = A[b] * B[b]): las matrices de un lote viven en una sola reserva
+// contigua, una tras otra a distancia fija (batchStride), así que no hay una
+// reserva por resultado y el recorrido es secuencial en memoria.
+
+// Vista no propietaria sobre un lote: count matrices rows x cols, cada fila
+// con stride elementos y cada matriz a batchStride elementos de la anterior
+template <typename T>
+class BatchView {
+public:
+    BatchView() = default;
+    BatchView(T* data, int count, int rows, int cols, int stride, size_t batchStride)
+        : data_(data), count_(count), rows_(rows), cols_(cols), stride_(stride), batchStride_(batchStride) {}
+
+    // Permite pasar un lote mutable donde se espera uno de solo lectura
+    template <typename U, typename = std::enable_if_t<std::is_same_v<const U, T>>>
+    BatchView(const BatchView<U>& other)
+        : data_(other.data()), count_(other.count()), rows_(other.rows()), cols_(other.cols()),
+          stride_(other.stride()), batchStride_(other.batchStride()) {}
+
+    MatrixView<T> operator[](int b) const {
+        return MatrixView<T>(data_ + (size_t)b * batchStride_, rows_, cols_, stride_);
+    }
+
+    T* data() const { return data_; }
+    int count() const { return count_; }
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    int stride() const { return stride_; }
+    size_t batchStride() const { return batchStride_; }
+
+private:
+    T* data_ = nullptr;
+    int count_ = 0;
+    int rows_ = 0;
+    int cols_ = 0;
+    int stride_ = 0;
+    size_t batchStride_ = 0;
+};
+
+// Lote propietario: una única reserva alineada (contabilizada, MemoryTracker.hpp)
+// inicializada a 0. Cada matriz empieza alineada a línea de caché.
+template <typename T>
+class MatrixBatch {
+public:
+    MatrixBatch() = default;
+
+    MatrixBatch(int count, int rows, int cols)
+        : count_(count), rows_(rows), cols_(cols), stride_(Matrix<T>::paddedStride(cols)) {
+        constexpr size_t perLine = MATRIX_ALIGNMENT % sizeof(T) == 0 ? MATRIX_ALIGNMENT / sizeof(T) : 1;
+        batchStride_ = ((size_t)rows_ * stride_ + perLine - 1) / perLine * perLine;
+        size_t bytes = this->bytes();
+        if (bytes == 0) return;
+        data_ = static_cast<T*>(alignedAllocate(MATRIX_ALIGNMENT, bytes));
+        std::memset(data_, 0, bytes);
+    }
+
+    MatrixBatch(const MatrixBatch&) = delete;
+    MatrixBatch& operator=(const MatrixBatch&) = delete;
+
+    MatrixBatch(MatrixBatch&& other) noexcept { swap(other); }
+
+    MatrixBatch& operator=(MatrixBatch&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~MatrixBatch() { alignedFree(data_, bytes()); }
+
+    void swap(MatrixBatch& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(count_, other.count_);
+        std::swap(rows_, other.rows_);
+        std::swap(cols_, other.cols_);
+        std::swap(stride_, other.stride_);
+        std::swap(batchStride_, other.batchStride_);
+    }
+
+    MatrixView<T> operator[](int b) { return view()[b]; }
+    MatrixView<const T> operator[](int b) const { return view()[b]; }
+
+    BatchView<T> view() { return BatchView<T>(data_, count_, rows_, cols_, stride_, batchStride_); }
+    BatchView<const T> view() const { return BatchView<const T>(data_, count_, rows_, cols_, stride_, batchStride_); }
+    operator BatchView<T>() { return view(); }
+    operator BatchView<const T>() const { return view(); }
+
+    int count() const { return count_; }
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+
+    size_t bytes() const {
+        size_t raw = (size_t)count_ * batchStride_ * sizeof(T);
+        return (raw + MATRIX_ALIGNMENT - 1) / MATRIX_ALIGNMENT * MATRIX_ALIGNMENT;
+    }
+
+private:
+    T* data_ = nullptr;
+    int count_ = 0;
+    int rows_ = 0;
+    int cols_ = 0;
+    int stride_ = 0;
+    size_t batchStride_ = 0;
+};
+
+// C[b] (+)= A[b] * B[b] para b en [0, count). Los hilos se reparten rangos
+// contiguos de índices del lote (cada matriz la hace un solo hilo, sin
+// sincronización dentro del producto). Hasta SMALL_GEMM_MAX se usa el kernel
+// pequeño sin empaquetado; por encima, el motor por bloques.
+template <typename T, typename Acc = T>
+void gemmBatched(BatchView<const T> A, BatchView<const T> B, BatchView<Acc> C, ThreadPool& pool,
+                 bool accumulate = false) {
+    int count = std::min(A.count(), std::min(B.count(), C.count()));
+    int M = A.rows(), K = A.cols(), N = B.cols();
+    bool small = std::max(M, std::max(K, N)) <= SMALL_GEMM_MAX;
+    SmallGemmKernel<T, Acc> kernel = smallGemmKernel<T, Acc>();
+    auto range = [=](int first, int last) {
+        for (int b = first; b < last; b++) {
+            if (small) {
+                kernel(A[b], B[b], C[b], accumulate);
+            } else {
+                gemm<T, Acc>(A[b], B[b], C[b], accumulate);
+            }
+        }
+    };
+
+    // Un lote pequeño no compensa repartirlo: ~64³ operaciones por tarea como mínimo
+    double work = (double)M * K * N * count;
+    int tasks = std::min(pool.size(), std::max(1, (int)(work / (64.0 * 64.0 * 64.0))));
+    tasks = std::min(tasks, count);
+    if (tasks <= 1) {
+        range(0, count);
+        return;
+    }
+    TaskGroup group(pool);
+    for (int t = 0; t < tasks; t++) {
+        int first = (int)((long long)count * t / tasks);
+        int last = (int)((long long)count * (t + 1) / tasks);
+        group.run([=] { range(first, last); });
+    }
+    group.wait();
+}
+
+template <typename T, typename Acc = T>
+void gemmBatched(BatchView<const T> A, BatchView<const T> B, BatchView<Acc> C, bool accumulate = false) {
+    gemmBatched<T, Acc>(A, B, C, defaultThreadPool(), accumulate);
+}
+
+#endif
@@ -0,0 +1,416 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Batched.hpp"
+#include "ElementType.hpp"
+#include "Gemm.hpp"
+#include "Matrix.hpp"
+#include "MemoryTracker.hpp"
+#include "RandomMatrix.hpp"
+#include "Simd.hpp"
+#include "Strassen.hpp"
+#include "ThreadPool.hpp"
+#include "Workspace.hpp"
+
+using namespace std;
+
+// Benchmark reproducible de los motores en C++: barrido de tamaños, rondas de
+// calentamiento, varias mediciones por tamaño y algoritmo (mediana, p95,
+// desviación estándar), GOP/s, hilos fijos a CPUs y semilla fija.
+// Escribe un CSV con el mismo esquema que guardar_csv del script de Python
+// (Tamaño (n), Algoritmo, Lenguaje, Tiempo (ms) = mediana, Memoria (MB)) y,
+// opcionalmente, un JSON con todas las mediciones. Con --batch N mide en su
+// lugar lotes de N productos pequeños: cada pareja por separado (Pares) contra
+// gemmBatched (Lotes).
+
+struct BenchOptions {
+    vector<int> sizes = {64, 128, 256, 512, 1024};
+    vector<string> algorithms = {"Naive", "Bloques", "Strassen", "Strassen-Winograd"};
+    int warmup = 1;
+    int trials = 5;
+    unsigned seed = 42;
+    int naiveMax = 1024; // El triple bucle es O(n³) sin bloques: solo hasta este N
+    string csvPath = "resultados.csv";
+    string jsonPath;
+    int batch = 0; // Productos por lote (0: barrido normal)
+};
+
+struct TrialStats {
+    double medianMs = 0, p95Ms = 0, meanMs = 0, stddevMs = 0, minMs = 0;
+};
+
+struct BenchResult {
+    int size;
+    string algorithm;
+    vector<double> timesMs;
+    TrialStats stats;
+    double gops;
+    double memoryMb;     // Pico medido: A y B + lo que reserva el algoritmo (C, arena, buffers)
+    size_t allocations;  // Reservas de una multiplicación (la última ronda)
+    double peakRssMb;    // Pico de RSS del proceso durante el algoritmo (getrusage)
+    bool correct;
+};
+
+// p95 por rango más cercano; desviación estándar muestral
+TrialStats computeStats(vector<double> times) {
+    TrialStats s;
+    if (times.empty()) return s;
+    sort(times.begin(), times.end());
+    size_t n = times.size();
+    s.minMs = times.front();
+    s.medianMs = n % 2 ? times[n / 2] : (times[n / 2 - 1] + times[n / 2]) / 2.0;
+    s.p95Ms = times[(size_t)ceil(0.95 * n) - 1];
+    double sum = 0;
+    for (double t : times) sum += t;
+    s.meanMs = sum / n;
+    double sq = 0;
+    for (double t : times) sq += (t - s.meanMs) * (t - s.meanMs);
+    s.stddevMs = n > 1 ? sqrt(sq / (n - 1)) : 0.0;
+    return s;
+}
+
+// Matriz n x n con enteros 0-9 de la semilla y el flujo dados (RandomMatrix.hpp)
+template <typename T>
+Matrix<T> seededMatrix(int n, uint64_t seed, uint32_t stream) {
+    Matrix<T> m(n, n);
+    fillRandomMatrix<T>(m.view(), seed, stream);
+    return m;
+}
+
+// Referencia de libro: triple bucle i-k-j, un hilo, sin bloques ni SIMD explícito
+template <typename T, typename Acc>
+void textbook_multiply(MatrixView<const T> A, MatrixView<const T> B, MatrixView<Acc> C) {
+    int M = A.rows(), K = A.cols(), N = B.cols();
+    for (int i = 0; i < M; i++) {
+        Acc* c = C[i];
+        fill(c, c + N, Acc(0));
+        for (int k = 0; k < K; k++) {
+            Acc a = Acc(A[i][k]);
+            const T* b = B[k];
+            for (int j = 0; j < N; j++) c[j] += a * Acc(b[j]);
+        }
+    }
+}
+
+// Igualdad exacta para enteros; tolerancia relativa para punto flotante
+template <typename Acc>
+bool sameResult(MatrixView<const Acc> X, MatrixView<const Acc> ref) {
+    for (int i = 0; i < ref.rows(); i++) {
+        for (int j = 0; j < ref.cols(); j++) {
+            if constexpr (is_floating_point_v<Acc>) {
+                double diff = fabs((double)X[i][j] - (double)ref[i][j]);
+                if (diff > 1e-4 * max(1.0, fabs((double)ref[i][j]))) return false;
+            } else if (X[i][j] != ref[i][j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Mide un algoritmo sobre A y B. La arena de Strassen se reserva fuera de la
+// medición de tiempo (se reutiliza en todas las rondas), como haría un usuario
+// del motor, pero sí cuenta en la memoria.
+template <typename T, typename Acc>
+BenchResult benchAlgorithm(const string& name, const Matrix<T>& A, const Matrix<T>& B, const Matrix<Acc>& ref,
+                           const BenchOptions& opt) {
+    MemoryMeasurement memory;
+    int n = A.rows();
+    bool strassen = name == "Strassen" || name == "Strassen-Winograd";
+    if (strassen) {
+        strassenVariant() = name == "Strassen" ? StrassenVariant::Classic : StrassenVariant::Winograd;
+    }
+    size_t wsBytes = strassen ? strassen_workspace_size<T, Acc>(n) : 0;
+    Workspace ws(wsBytes);
+    Matrix<Acc> C(n, n);
+
+    auto run = [&] {
+        if (name == "Naive") {
+            textbook_multiply<T, Acc>(A, B, C);
+        } else if (name == "Bloques") {
+            gemmParallel<T, Acc>(A, B, C, defaultThreadPool());
+        } else {
+            strassen_multiply<T, Acc>(A, B, C, ws);
+        }
+    };
+
+    for (int w = 0; w < opt.warmup; w++) run();
+    BenchResult r;
+    r.size = n;
+    r.algorithm = name;
+    size_t allocsBefore = 0;
+    for (int t = 0; t < opt.trials; t++) {
+        allocsBefore = MemoryTracker::instance().stats().allocations;
+        auto start = chrono::steady_clock::now();
+        run();
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        r.timesMs.push_back(elapsed.count());
+    }
+    r.allocations = MemoryTracker::instance().stats().allocations - allocsBefore;
+    MemoryReport mem = memory.finish();
+    r.stats = computeStats(r.timesMs);
+    // Operaciones nominales 2n³ aunque Strassen haga menos: GOP/s efectivos
+    r.gops = r.stats.medianMs > 0 ? 2.0 * n * n * (double)n / (r.stats.medianMs * 1e6) : 0.0;
+    r.memoryMb = (double)(A.bytes() + B.bytes() + mem.peakExtraBytes()) / (1024.0 * 1024.0);
+    r.peakRssMb = (double)mem.peakRss / (1024.0 * 1024.0);
+    r.correct = sameResult<Acc>(C, ref);
+    return r;
+}
+
+// Mide un lote de productos pequeños. Pares: una multiplicación y una reserva
+// de resultado por pareja, como naive_multiply. Lotes: gemmBatched sobre
+// lotes contiguos, sin reservas durante la medición.
+template <typename T, typename Acc>
+BenchResult benchBatch(const string& name, const MatrixBatch<T>& A, const MatrixBatch<T>& B,
+                       const MatrixBatch<Acc>& ref, const BenchOptions& opt) {
+    MemoryMeasurement memory;
+    int n = A.rows(), count = A.count();
+    MatrixBatch<Acc> C = name == "Lotes" ? MatrixBatch<Acc>(count, n, n) : MatrixBatch<Acc>();
+    vector<Matrix<Acc>> pairs(name == "Lotes" ? 0 : count);
+
+    auto run = [&] {
+        if (name == "Lotes") {
+            gemmBatched<T, Acc>(A, B, C);
+            return;
+        }
+        for (int b = 0; b < count; b++) {
+            pairs[b] = Matrix<Acc>(n, n);
+            gemm<T, Acc>(A[b], B[b], pairs[b]);
+        }
+    };
+
+    for (int w = 0; w < opt.warmup; w++) run();
+    BenchResult r;
+    r.size = n;
+    r.algorithm = name;
+    size_t allocsBefore = 0;
+    for (int t = 0; t < opt.trials; t++) {
+        allocsBefore = MemoryTracker::instance().stats().allocations;
+        auto start = chrono::steady_clock::now();
+        run();
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        r.timesMs.push_back(elapsed.count());
+    }
+    r.allocations = MemoryTracker::instance().stats().allocations - allocsBefore;
+    MemoryReport mem = memory.finish();
+    r.stats = computeStats(r.timesMs);
+    r.gops = r.stats.medianMs > 0 ? 2.0 * n * n * (double)n * count / (r.stats.medianMs * 1e6) : 0.0;
+    r.memoryMb = (double)(A.bytes() + B.bytes() + mem.peakExtraBytes()) / (1024.0 * 1024.0);
+    r.peakRssMb = (double)mem.peakRss / (1024.0 * 1024.0);
+    r.correct = true;
+    for (int b = 0; b < count && r.correct; b++) {
+        r.correct = sameResult<Acc>(name == "Lotes" ? C[b] : pairs[b].view(), ref[b]);
+    }
+    return r;
+}
+
+string round2(double v) {
+    ostringstream out;
+    out << fixed << setprecision(2) << v;
+    return out.str();
+}
+
+// Mismo esquema que guardar_csv en el script de Python
+bool writeCsv(const string& path, const vector<BenchResult>& results) {
+    ofstream out(path);
+    if (!out) return false;
+    out << "Tamaño (n),Algoritmo,Lenguaje,Tiempo (ms),Memoria (MB)\r\n";
+    for (const BenchResult& r : results) {
+        out << r.size << "," << r.algorithm << ",C++," << round2(r.stats.medianMs) << "," << round2(r.memoryMb)
+            << "\r\n";
+    }
+    return (bool)out;
+}
+
+bool writeJson(const string& path, const vector<BenchResult>& results, ElementType type, const BenchOptions& opt) {
+    ofstream out(path);
+    if (!out) return false;
+    out << "{\n";
+    out << "  \"lenguaje\": \"C++\",\n";
+    out << "  \"tipo\": \"" << elementTypeName(type) << "\",\n";
+    out << "  \"kernel_simd\": \"" << simdIsaName(simdKernels().isa) << "\",\n";
+    out << "  \"hilos\": " << defaultThreadPool().size() << ",\n";
+    out << "  \"hilos_fijos\": " << (defaultThreadPinning() ? "true" : "false") << ",\n";
+    out << "  \"semilla\": " << opt.seed << ",\n";
+    out << "  \"calentamiento\": " << opt.warmup << ",\n";
+    out << "  \"rondas\": " << opt.trials << ",\n";
+    out << "  \"umbral_strassen\": " << strassenThreshold() << ",\n";
+    if (opt.batch > 0) out << "  \"productos_por_lote\": " << opt.batch << ",\n";
+    out << "  \"resultados\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        out << "    {\"n\": " << r.size << ", \"algoritmo\": \"" << r.algorithm << "\", \"tiempo_ms\": "
+            << r.stats.medianMs << ", \"p95_ms\": " << r.stats.p95Ms << ", \"media_ms\": " << r.stats.meanMs
+            << ", \"desviacion_ms\": " << r.stats.stddevMs << ", \"min_ms\": " << r.stats.minMs
+            << ", \"gops\": " << r.gops << ", \"memoria_mb\": " << r.memoryMb << ", \"reservas\": " << r.allocations
+            << ", \"rss_max_mb\": " << r.peakRssMb
+            << ", \"correcto\": " << (r.correct ? "true" : "false") << ", \"tiempos_ms\": [";
+        for (size_t t = 0; t < r.timesMs.size(); t++) out << (t ? ", " : "") << r.timesMs[t];
+        out << "]}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return (bool)out;
+}
+
+void printResult(const BenchResult& r) {
+    cout << r.size << "\t" << left << setw(16) << r.algorithm << right << "\t" << r.stats.medianMs << "\t\t"
+         << r.stats.p95Ms << "\t\t" << r.stats.stddevMs << "\t\t" << r.gops << "\t" << r.memoryMb << "\t\t"
+         << r.allocations << "\t\t" << r.peakRssMb << "\t\t" << (r.correct ? "sí" : "NO") << "\n";
+}
+
+const char* RESULT_HEADER =
+    "N\tAlgoritmo\t\tMediana (ms)\tp95 (ms)\tDesv. (ms)\tGOP/s\tMemoria (MB)\tReservas\tRSS (MB)\tCorrecto\n";
+
+template <typename T, typename Acc>
+vector<BenchResult> runSweep(const BenchOptions& opt) {
+    vector<BenchResult> results;
+    cout << RESULT_HEADER;
+    for (int n : opt.sizes) {
+        // Semilla por tamaño: las entradas de cada N no dependen del barrido
+        uint64_t seed = opt.seed + (uint64_t)n;
+        Matrix<T> A = seededMatrix<T>(n, seed, 0), B = seededMatrix<T>(n, seed, 1);
+        Matrix<Acc> ref(n, n);
+        gemm<T, Acc>(A, B, ref);
+
+        for (const string& name : opt.algorithms) {
+            if (name == "Naive" && n > opt.naiveMax) continue;
+            BenchResult r = benchAlgorithm<T, Acc>(name, A, B, ref, opt);
+            printResult(r);
+            results.push_back(r);
+        }
+    }
+    return results;
+}
+
+// Barrido de lotes: opt.batch productos n x n por tamaño, mismas semillas por N
+template <typename T, typename Acc>
+vector<BenchResult> runBatchSweep(const BenchOptions& opt) {
+    vector<BenchResult> results;
+    cout << "Productos por lote: " << opt.batch << "\n" << RESULT_HEADER;
+    for (int n : opt.sizes) {
+        uint64_t seed = opt.seed + (uint64_t)n;
+        MatrixBatch<T> A(opt.batch, n, n), B(opt.batch, n, n);
+        MatrixBatch<Acc> ref(opt.batch, n, n);
+        for (int b = 0; b < opt.batch; b++) {
+            fillRandomMatrix<T>(A[b], seed, 2 * (uint32_t)b);
+            fillRandomMatrix<T>(B[b], seed, 2 * (uint32_t)b + 1);
+            gemm<T, Acc>(A[b], B[b], ref[b]);
+        }
+
+        for (const string& name : opt.algorithms) {
+            BenchResult r = benchBatch<T, Acc>(name, A, B, ref, opt);
+            printResult(r);
+            results.push_back(r);
+        }
+    }
+    return results;
+}
+
+vector<string> splitList(const string& list) {
+    vector<string> items;
+    stringstream in(list);
+    string item;
+    while (getline(in, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+int main(int argc, char* argv[]) {
+    // Opciones: --sizes 64,128,...  (tamaños N a barrer)
+    //           --algorithms Naive,Bloques,Strassen,Strassen-Winograd
+    //           --warmup N --trials N (rondas de calentamiento y medidas; por defecto 1 y 5)
+    //           --seed S        (semilla de las matrices; por defecto 42)
+    //           --naive-max N   (N máximo para el triple bucle; por defecto 1024)
+    //           --threads N --pin (hilos del pool y fijarlos a CPUs)
+    //           --type T        (int32, int32-acc64, int64, float, double)
+    //           --csv archivo   (por defecto resultados.csv) --json archivo
+    //           --batch N       (lotes de N productos pequeños: Pares y Lotes; tamaños por defecto 8,16,32,64)
+    BenchOptions opt;
+    ElementType type = ElementType::Int32;
+    bool sizesGiven = false, algorithmsGiven = false;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--sizes" && hasValue) {
+            opt.sizes.clear();
+            sizesGiven = true;
+            for (const string& s : splitList(argv[++i])) opt.sizes.push_back(atoi(s.c_str()));
+        } else if (arg == "--algorithms" && hasValue) {
+            opt.algorithms = splitList(argv[++i]);
+            algorithmsGiven = true;
+        } else if (arg == "--warmup" && hasValue) {
+            opt.warmup = max(0, atoi(argv[++i]));
+        } else if (arg == "--trials" && hasValue) {
+            opt.trials = max(1, atoi(argv[++i]));
+        } else if (arg == "--seed" && hasValue) {
+            opt.seed = (unsigned)strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--naive-max" && hasValue) {
+            opt.naiveMax = atoi(argv[++i]);
+        } else if (arg == "--threads" && hasValue) {
+            setDefaultThreadCount(atoi(argv[++i]));
+        } else if (arg == "--pin") {
+            setDefaultThreadPinning(true);
+        } else if (arg == "--type" && hasValue) {
+            if (!parseElementType(argv[++i], type)) {
+                cout << "Tipo no válido: " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (arg == "--csv" && hasValue) {
+            opt.csvPath = argv[++i];
+        } else if (arg == "--json" && hasValue) {
+            opt.jsonPath = argv[++i];
+        } else if (arg == "--batch" && hasValue) {
+            opt.batch = max(1, atoi(argv[++i]));
+        } else {
+            cout << "Opción no reconocida: " << arg << "\n";
+            return 1;
+        }
+    }
+    if (opt.batch > 0) {
+        if (!sizesGiven) opt.sizes = {8, 16, 32, 64};
+        if (!algorithmsGiven) opt.algorithms = {"Pares", "Lotes"};
+    }
+    for (const string& name : opt.algorithms) {
+        bool valid = opt.batch > 0 ? (name == "Pares" || name == "Lotes")
+                                   : (name == "Naive" || name == "Bloques" || name == "Strassen" ||
+                                      name == "Strassen-Winograd");
+        if (!valid) {
+            cout << "Algoritmo no válido: " << name << "\n";
+            return 1;
+        }
+    }
+
+    cout << "BENCHMARK DE MULTIPLICACIÓN DE MATRICES (C++)\n";
+    cout << "-------------------------------------------------------\n";
+    cout << "Kernel SIMD: " << simdIsaName(simdKernels().isa) << "\n";
+    cout << "Hilos: " << defaultThreadPool().size() << (defaultThreadPinning() ? " (fijos)" : "") << "\n";
+    cout << "Tipo de elemento: " << elementTypeName(type) << "\n";
+    cout << "Umbral de Strassen: " << strassenThreshold() << "\n";
+    cout << "Semilla: " << opt.seed << ", calentamiento: " << opt.warmup << ", rondas: " << opt.trials << "\n\n";
+
+    vector<BenchResult> results = dispatchElementType(type, [&](auto t, auto acc) {
+        using T = decltype(t);
+        using Acc = decltype(acc);
+        return opt.batch > 0 ? runBatchSweep<T, Acc>(opt) : runSweep<T, Acc>(opt);
+    });
+
+    bool ok = all_of(results.begin(), results.end(), [](const BenchResult& r) { return r.correct; });
+    cout << "\n" << (ok ? "Todos los resultados coinciden con el motor por bloques.\n"
+                        : "ATENCIÓN: hay resultados que no coinciden.\n");
+    cout << (writeCsv(opt.csvPath, results) ? "CSV guardado en " : "No se pudo escribir el CSV ") << opt.csvPath << "\n";
+    if (!opt.jsonPath.empty()) {
+        cout << (writeJson(opt.jsonPath, results, type, opt) ? "JSON guardado en " : "No se pudo escribir el JSON ")
+             << opt.jsonPath << "\n";
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,246 @@
+#ifndef CHAIN_HPP
+#define CHAIN_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Matrix.hpp"
+#include "Strassen.hpp"
+#include "ThreadPool.hpp"
+#include "Workspace.hpp"
+
+// Producto de una cadena A1 * A2 * ... * An. El orden de los paréntesis no
+// cambia el resultado pero sí el trabajo: con A (10 x 1000), B (1000 x 10) y
+// C (10 x 1000), (A * B) * C cuesta 2e5 multiplicaciones y A * (B * C), 2e7.
+// MatrixChainPlan elige los paréntesis por programación dinámica (la de
+// "matrix-chain order", O(n³) en la longitud de la cadena) con el coste del
+// algoritmo que de verdad ejecutará cada paso (chainProductCost: motor por
+// bloques o niveles de Strassen con sus sumas).
+//
+// chain_multiply ejecuta el árbol del plan: los dos operandos de un paso que
+// son productos intermedios se calculan a la vez como tareas del pool (el
+// grafo de dependencias de una cadena es ese árbol) y cada paso usa el pool
+// entero a través de multiply_into. Los intermedios y los temporales de
+// Strassen salen de una sola arena: el resultado de un paso se libera en
+// cuanto lo consume su padre y su espacio lo reutiliza el siguiente.
+
+// Coste relativo de sumar un elemento en una pasada de Strassen frente a una
+// operación del motor por bloques: las sumas van limitadas por memoria y el
+// microkernel hace varias operaciones por ciclo y por carril SIMD
+constexpr double CHAIN_ADD_COST = 8.0;
+
+// Coste estimado de C (M x N) = A (M x K) * B (K x N) en operaciones del motor:
+// 2 * M * K * N en el caso base; si no, 7 productos de la mitad, las sumas de
+// un nivel de la variante en uso y los productos delgados de la parte impar
+inline double chainProductCost(int M, int K, int N) {
+    if (M <= 0 || K <= 0 || N <= 0) return 0.0;
+    if (strassen_is_base(M, K, N)) return 2.0 * M * K * (double)N;
+    int m2 = M / 2, k2 = K / 2, n2 = N / 2;
+    double a = (double)m2 * k2, b = (double)k2 * n2, c = (double)m2 * n2;
+    double sums = strassenVariant() == StrassenVariant::Winograd ? 4 * a + 4 * b + 7 * c : 5 * a + 5 * b + 8 * c;
+    double odd = 2.0 * ((double)M * K * N - 8.0 * m2 * k2 * (double)n2);
+    return 7.0 * chainProductCost(m2, k2, n2) + CHAIN_ADD_COST * sums + odd;
+}
+
+// Paréntesis elegidos para una cadena de dims.size() - 1 matrices, la i de
+// dims[i] x dims[i + 1]
+class MatrixChainPlan {
+public:
+    MatrixChainPlan() = default;
+
+    MatrixChainPlan(std::vector<int> dims) : dims_(std::move(dims)) {
+        int n = length();
+        if (n < 1) throw std::invalid_argument("La cadena necesita al menos una matriz");
+        for (int d : dims_) {
+            if (d <= 0) throw std::invalid_argument("Dimensión no válida en la cadena: " + std::to_string(d));
+        }
+        // cost[i][j]: mejor coste de Ai..Aj; split[i][j]: último producto (Ai..As) * (As+1..Aj)
+        std::vector<double> cost((size_t)n * n, 0.0);
+        split_.assign((size_t)n * n, 0);
+        for (int len = 2; len <= n; len++) {
+            for (int i = 0; i + len - 1 < n; i++) {
+                int j = i + len - 1;
+                double best = std::numeric_limits<double>::infinity();
+                // De derecha a izquierda: con empate gana el orden escrito, ((Ai Ai+1) ...) Aj
+                for (int s = j - 1; s >= i; s--) {
+                    double c = cost[i * n + s] + cost[(s + 1) * n + j] +
+                               chainProductCost(dims_[i], dims_[s + 1], dims_[j + 1]);
+                    if (c < best) {
+                        best = c;
+                        split_[i * n + j] = s;
+                    }
+                }
+                cost[i * n + j] = best;
+            }
+        }
+        cost_ = cost[n - 1];
+        for (int j = 1; j < n; j++) leftToRightCost_ += chainProductCost(dims_[0], dims_[j], dims_[j + 1]);
+    }
+
+    int length() const { return (int)dims_.size() - 1; }
+    const std::vector<int>& dims() const { return dims_; }
+    int rows(int i) const { return dims_[i]; }     // Filas de Ai (y de todo producto que empieza en Ai)
+    int cols(int j) const { return dims_[j + 1]; } // Columnas de Aj (y de todo producto que acaba en Aj)
+    int split(int i, int j) const { return split_[i * length() + j]; }
+
+    double cost() const { return cost_; }                       // Coste con los paréntesis elegidos
+    double leftToRightCost() const { return leftToRightCost_; } // ((A1 * A2) * A3) * ...
+
+    // Paréntesis como texto, p. ej. "((A1 A2) A3)"
+    std::string toString() const { return length() > 0 ? describe(0, length() - 1) : std::string(); }
+
+private:
+    std::string describe(int i, int j) const {
+        if (i == j) return "A" + std::to_string(i + 1);
+        int s = split(i, j);
+        return "(" + describe(i, s) + " " + describe(s + 1, j) + ")";
+    }
+
+    std::vector<int> dims_;
+    std::vector<int> split_;
+    double cost_ = 0.0;
+    double leftToRightCost_ = 0.0;
+};
+
+// Dimensiones de la cadena (dims[i] x dims[i + 1] para la matriz i); lanza
+// invalid_argument si dos matrices consecutivas no se pueden multiplicar
+template <typename T>
+std::vector<int> matrixChainDims(const std::vector<MatrixView<const T>>& mats) {
+    std::vector<int> dims;
+    if (mats.empty()) return dims;
+    dims.push_back(mats[0].rows());
+    for (size_t i = 0; i < mats.size(); i++) {
+        if (mats[i].rows() != dims.back()) {
+            throw std::invalid_argument("Dimensiones incompatibles en la cadena: la matriz " + std::to_string(i + 1) +
+                                        " tiene " + std::to_string(mats[i].rows()) + " filas, se esperaban " +
+                                        std::to_string(dims.back()));
+        }
+        dims.push_back(mats[i].cols());
+    }
+    return dims;
+}
+
+// Los dos operandos intermedios de un paso se calculan en paralelo solo si
+// hay más de un hilo (la misma decisión al dimensionar la arena y al ejecutar)
+inline bool chainForks(int i, int s, int j) {
+    return s > i && j > s + 1 && defaultThreadPool().size() > 1;
+}
+
+// Arena del paso Ai..Aj sin contar su resultado: intermedios de sus
+// operandos, la de cada operando (en paralelo, una región para cada uno) y la
+// de Strassen para el producto. Si Acc es más ancho que T y solo un operando
+// es intermedio, el otro (una matriz de la cadena) se amplía a Acc.
+template <typename T, typename Acc>
+size_t chainStepWorkspaceSize(const MatrixChainPlan& plan, int i, int j) {
+    int s = plan.split(i, j);
+    bool leftNode = s > i, rightNode = j > s + 1;
+    int M = plan.rows(i), K = plan.cols(s), N = plan.cols(j);
+    size_t resL = leftNode ? Workspace::matrixBytes<Acc>(M, K) : 0;
+    size_t resR = rightNode ? Workspace::matrixBytes<Acc>(K, N) : 0;
+    size_t needL = leftNode ? chainStepWorkspaceSize<T, Acc>(plan, i, s) : 0;
+    size_t needR = rightNode ? chainStepWorkspaceSize<T, Acc>(plan, s + 1, j) : 0;
+
+    // Con beta = 0 multiply_into solo usa la arena de Strassen
+    size_t product;
+    if (!leftNode && !rightNode) {
+        product = strassen_workspace_size<T, Acc>(M, K, N);
+    } else {
+        product = strassen_workspace_size<Acc, Acc>(M, K, N);
+        if (!std::is_same_v<T, Acc>) {
+            if (!leftNode) product += Workspace::matrixBytes<Acc>(M, K);
+            if (!rightNode) product += Workspace::matrixBytes<Acc>(K, N);
+        }
+    }
+    if (chainForks(i, s, j)) return std::max(resL + resR + needL + needR, resL + resR + product);
+    return std::max({resL + needL, resL + resR + needR, resL + resR + product});
+}
+
+// Bytes de arena que necesita chain_multiply con este plan (sin el resultado)
+template <typename T, typename Acc = T>
+size_t chain_workspace_size(const MatrixChainPlan& plan) {
+    return plan.length() > 1 ? chainStepWorkspaceSize<T, Acc>(plan, 0, plan.length() - 1) : 0;
+}
+
+// Operando de un paso en Acc: el intermedio tal cual, o la matriz de la
+// cadena, ampliada en la arena si T no es Acc
+template <typename T, typename Acc>
+MatrixView<const Acc> chainOperand(MatrixView<const T> leaf, MatrixView<Acc> node, bool isNode, Workspace& ws) {
+    if (isNode) return node;
+    if constexpr (std::is_same_v<T, Acc>) {
+        return leaf;
+    } else {
+        MatrixView<Acc> wide = ws.allocateMatrix<Acc>(leaf.rows(), leaf.cols());
+        for (int r = 0; r < leaf.rows(); r++) std::copy(leaf[r], leaf[r] + leaf.cols(), wide[r]);
+        return wide;
+    }
+}
+
+// C = Ai * ... * Aj (j > i) según el plan, con los temporales en ws
+template <typename T, typename Acc>
+void chainStep(const MatrixChainPlan& plan, const std::vector<MatrixView<const T>>& mats, int i, int j,
+               MatrixView<Acc> C, Workspace& ws) {
+    int s = plan.split(i, j);
+    bool leftNode = s > i, rightNode = j > s + 1;
+    int M = plan.rows(i), K = plan.cols(s), N = plan.cols(j);
+    WorkspaceScope scope(ws);
+    MatrixView<Acc> left, right;
+    if (leftNode) left = ws.allocateMatrix<Acc>(M, K);
+
+    if (chainForks(i, s, j)) {
+        right = ws.allocateMatrix<Acc>(K, N);
+        WorkspaceScope regions(ws);
+        size_t needL = chainStepWorkspaceSize<T, Acc>(plan, i, s);
+        size_t needR = chainStepWorkspaceSize<T, Acc>(plan, s + 1, j);
+        Workspace wsL(ws.allocateBytes(needL), Workspace::alignUp(needL));
+        Workspace wsR(ws.allocateBytes(needR), Workspace::alignUp(needR));
+        TaskGroup group(defaultThreadPool());
+        group.run([&] { chainStep<T, Acc>(plan, mats, i, s, left, wsL); });
+        chainStep<T, Acc>(plan, mats, s + 1, j, right, wsR);
+        group.wait();
+    } else {
+        if (leftNode) chainStep<T, Acc>(plan, mats, i, s, left, ws);
+        if (rightNode) {
+            right = ws.allocateMatrix<Acc>(K, N);
+            chainStep<T, Acc>(plan, mats, s + 1, j, right, ws);
+        }
+    }
+
+    if (!leftNode && !rightNode) {
+        multiply_into<T, Acc>(C, mats[i], mats[j], Acc(1), Acc(0), ws);
+        return;
+    }
+    MatrixView<const Acc> a = chainOperand<T, Acc>(mats[i], left, leftNode, ws);
+    MatrixView<const Acc> b = chainOperand<T, Acc>(mats[j], right, rightNode, ws);
+    multiply_into<Acc, Acc>(C, a, b, Acc(1), Acc(0), ws);
+}
+
+// C = A1 * ... * An con los paréntesis del plan, sin reservar: los
+// intermedios salen de ws (al menos chain_workspace_size bytes libres)
+template <typename T, typename Acc = T>
+void chain_multiply(MatrixView<Acc> C, const std::vector<MatrixView<const T>>& mats, const MatrixChainPlan& plan,
+                    Workspace& ws) {
+    int n = plan.length();
+    if (n == 1) {
+        for (int r = 0; r < C.rows(); r++) std::copy(mats[0][r], mats[0][r] + C.cols(), C[r]);
+        return;
+    }
+    chainStep<T, Acc>(plan, mats, 0, n - 1, C, ws);
+}
+
+// A1 * ... * An con el orden de menor coste. Lanza invalid_argument si la
+// cadena está vacía o las dimensiones no encajan.
+template <typename T, typename Acc = T>
+Matrix<Acc> chain_multiply(const std::vector<MatrixView<const T>>& mats) {
+    MatrixChainPlan plan(matrixChainDims<T>(mats));
+    Workspace ws(chain_workspace_size<T, Acc>(plan));
+    Matrix<Acc> C(plan.dims().front(), plan.dims().back());
+    chain_multiply<T, Acc>(C, mats, plan, ws);
+    return C;
+}
+
+#endif
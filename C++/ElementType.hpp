@@ -0,0 +1,47 @@
+#ifndef ELEMENT_TYPE_HPP
+#define ELEMENT_TYPE_HPP
+
+#include <cstdint>
+#include <string>
+
+// Tipo de elemento de los programas de prueba (opción --type):
+//   int32        elementos y acumulación int32 (por defecto; puede desbordar)
+//   int32-acc64  elementos int32, resultado y acumulación int64 (exacto)
+//   int64, float, double
+enum class ElementType { Int32, Int32Acc64, Int64, Float, Double };
+
+inline const char* elementTypeName(ElementType type) {
+    switch (type) {
+        case ElementType::Int32Acc64: return "int32 (acumulación int64)";
+        case ElementType::Int64: return "int64";
+        case ElementType::Float: return "float";
+        case ElementType::Double: return "double";
+        default: return "int32";
+    }
+}
+
+// false si el nombre no corresponde a ningún tipo
+inline bool parseElementType(const std::string& name, ElementType& type) {
+    if (name == "int32") type = ElementType::Int32;
+    else if (name == "int32-acc64") type = ElementType::Int32Acc64;
+    else if (name == "int64") type = ElementType::Int64;
+    else if (name == "float") type = ElementType::Float;
+    else if (name == "double") type = ElementType::Double;
+    else return false;
+    return true;
+}
+
+// Llama a f(T{}, Acc{}) con el par (elemento, acumulador) de type; f suele ser
+// una lambda genérica que recupera los tipos con decltype.
+template <typename F>
+auto dispatchElementType(ElementType type, F&& f) {
+    switch (type) {
+        case ElementType::Int32Acc64: return f(std::int32_t{}, std::int64_t{});
+        case ElementType::Int64: return f(std::int64_t{}, std::int64_t{});
+        case ElementType::Float: return f(float{}, float{});
+        case ElementType::Double: return f(double{}, double{});
+        default: return f(std::int32_t{}, std::int32_t{});
+    }
+}
+
+#endif
@@ -0,0 +1,256 @@
+#ifndef GEMM_HPP
+#define GEMM_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+
+#include "Matrix.hpp"
+#include "Simd.hpp"
+#include "ThreadPool.hpp"
+#include "Tuning.hpp"
+
+// Multiplicación por bloques al estilo GotoBLAS:
+//  - jc recorre bloques de NC columnas de B/C (panel de B en L3)
+//  - pc recorre bloques de KC de la dimensión interna (panel de B empaquetado)
+//  - ic recorre bloques de MC filas de A/C (bloque de A empaquetado en L2)
+//  - el microkernel calcula un tile MR x NR de C en registros (astilla de B en L1)
+// MR, NR y los microkernels (escalar y SIMD) están en Simd.hpp.
+//
+// Tipos: los elementos de A y B son T y el producto se acumula en Acc (por
+// defecto el mismo tipo). Con T = int32 y Acc = int64 los paneles se amplían
+// al empaquetar y el resultado es exacto mientras K * max|a| * max|b| < 2^63.
+
+// Tamaños de bloque configurables en tiempo de ejecución
+struct GemmBlocking {
+    int mc = 128;
+    int kc = 256;
+    int nc = 2048;
+};
+
+// Ajusta los bloques para que sean múltiplos del tile de registros
+inline GemmBlocking normalizeBlocking(GemmBlocking b) {
+    b.mc = std::max(GEMM_MR, b.mc / GEMM_MR * GEMM_MR);
+    b.kc = std::max(1, b.kc);
+    b.nc = std::max(GEMM_NR, b.nc / GEMM_NR * GEMM_NR);
+    return b;
+}
+
+// Bloques iniciales: GEMM_MC/GEMM_KC/GEMM_NC, si no el archivo de tuning
+// (gemm_mc, gemm_kc, gemm_nc), si no los valores por defecto
+inline GemmBlocking initialBlocking() {
+    GemmBlocking b;
+    b.mc = tunedInt("GEMM_MC", "gemm_mc", b.mc);
+    b.kc = tunedInt("GEMM_KC", "gemm_kc", b.kc);
+    b.nc = tunedInt("GEMM_NC", "gemm_nc", b.nc);
+    return normalizeBlocking(b);
+}
+
+inline GemmBlocking& gemmBlocking() {
+    static GemmBlocking blocking = initialBlocking();
+    return blocking;
+}
+
+inline void setGemmBlocking(const GemmBlocking& b) {
+    gemmBlocking() = normalizeBlocking(b);
+}
+
+// Buffer de empaquetado por hilo; crece solo cuando hace falta, así que
+// tras la primera llamada la multiplicación no toca el heap.
+template <typename T>
+T* gemmPackBuffer(int slot, size_t elems) {
+    thread_local Matrix<T> buffers[2];
+    Matrix<T>& buf = buffers[slot];
+    if ((size_t)buf.cols() < elems) buf = Matrix<T>(1, (int)elems);
+    return buf.data();
+}
+
+// Operando de GEMM: X, o la combinación X + Y / X - Y (sign = +1 / -1).
+// Permite que Strassen fusione la suma de sus operandos en el empaquetado
+// en lugar de escribirla antes en un temporal.
+template <typename T>
+struct GemmOperand {
+    MatrixView<const T> x;
+    MatrixView<const T> y;
+    int sign = 0;
+
+    GemmOperand(MatrixView<const T> x) : x(x) {}
+    GemmOperand(MatrixView<const T> x, MatrixView<const T> y, int sign) : x(x), y(y), sign(sign) {}
+
+    int rows() const { return x.rows(); }
+    int cols() const { return x.cols(); }
+
+    GemmOperand block(int row, int col, int nrows, int ncols) const {
+        if (sign == 0) return GemmOperand(x.block(row, col, nrows, ncols));
+        return GemmOperand(x.block(row, col, nrows, ncols), y.block(row, col, nrows, ncols), sign);
+    }
+
+    // Elemento (i, j) evaluado en el tipo R (la suma no desborda T si R es más ancho)
+    template <typename R = T>
+    R at(int i, int j) const {
+        if (sign == 0) return R(x[i][j]);
+        return sign > 0 ? R(x[i][j]) + R(y[i][j]) : R(x[i][j]) - R(y[i][j]);
+    }
+};
+
+// Empaqueta un bloque mb x kb de A en astillas de MR filas: para cada k,
+// los MR valores de la columna quedan contiguos. Las filas sobrantes van a 0.
+template <typename T, typename Acc>
+void packA(const GemmOperand<T>& A, Acc* packed) {
+    int mb = A.rows(), kb = A.cols();
+    for (int ir = 0; ir < mb; ir += GEMM_MR) {
+        int mr = std::min(GEMM_MR, mb - ir);
+        for (int k = 0; k < kb; k++) {
+            for (int i = 0; i < mr; i++) packed[i] = A.template at<Acc>(ir + i, k);
+            for (int i = mr; i < GEMM_MR; i++) packed[i] = Acc(0);
+            packed += GEMM_MR;
+        }
+    }
+}
+
+// Empaqueta un bloque kb x nb de B en astillas de NR columnas (filas contiguas)
+template <typename T, typename Acc>
+void packB(const GemmOperand<T>& B, Acc* packed) {
+    int kb = B.rows(), nb = B.cols();
+    for (int jr = 0; jr < nb; jr += GEMM_NR) {
+        int nr = std::min(GEMM_NR, nb - jr);
+        for (int k = 0; k < kb; k++) {
+            const T* x = B.x[k] + jr;
+            if (B.sign == 0) {
+                for (int j = 0; j < nr; j++) packed[j] = Acc(x[j]);
+            } else if (B.sign > 0) {
+                const T* y = B.y[k] + jr;
+                for (int j = 0; j < nr; j++) packed[j] = Acc(x[j]) + Acc(y[j]);
+            } else {
+                const T* y = B.y[k] + jr;
+                for (int j = 0; j < nr; j++) packed[j] = Acc(x[j]) - Acc(y[j]);
+            }
+            for (int j = nr; j < GEMM_NR; j++) packed[j] = Acc(0);
+            packed += GEMM_NR;
+        }
+    }
+}
+
+// int32, int64, float y double usan el kernel SIMD elegido al arrancar; el
+// resto de tipos, el escalar. La elección por tipo se resuelve al compilar.
+template <typename T>
+MicroKernel<T> selectMicroKernel() {
+    if constexpr (std::is_same_v<T, int>) {
+        return simdKernels().microKernelInt32;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return simdKernels().microKernelFloat;
+    } else if constexpr (std::is_same_v<T, double>) {
+        return simdKernels().microKernelDouble;
+    } else if constexpr (std::is_same_v<T, std::int64_t>) {
+        return simdKernels().microKernelInt64;
+    } else {
+        return microKernelScalar<T>;
+    }
+}
+
+// Recorre el bloque mb x nb de C con el microkernel sobre los paneles empaquetados
+template <typename T>
+void macroKernel(int mb, int nb, int kb, const T* packedA, const T* packedB, MatrixView<T> C, bool accumulate) {
+    MicroKernel<T> microKernel = selectMicroKernel<T>();
+    for (int jr = 0; jr < nb; jr += GEMM_NR) {
+        int nr = std::min(GEMM_NR, nb - jr);
+        const T* b = packedB + (size_t)jr * kb;
+        for (int ir = 0; ir < mb; ir += GEMM_MR) {
+            int mr = std::min(GEMM_MR, mb - ir);
+            const T* a = packedA + (size_t)ir * kb;
+            microKernel(kb, a, b, C[ir] + jr, C.stride(), mr, nr, accumulate);
+        }
+    }
+}
+
+// C = A * B, o C += A * B si accumulate es true, con A y B dados como
+// combinaciones X +/- Y que se evalúan al empaquetar.
+// A es M x K, B es K x N y C es M x N; C no debe solaparse con A ni con B.
+template <typename T, typename Acc = T>
+void gemmFused(const GemmOperand<T>& A, const GemmOperand<T>& B, MatrixView<Acc> C, bool accumulate = false) {
+    int M = A.rows(), K = A.cols(), N = B.cols();
+    if (M == 0 || N == 0) return;
+    if (K == 0) {
+        if (!accumulate) {
+            for (int i = 0; i < M; i++) std::fill(C[i], C[i] + N, Acc(0));
+        }
+        return;
+    }
+
+    const GemmBlocking& blk = gemmBlocking();
+    int kcMax = std::min(blk.kc, K);
+    int mcMax = std::min(blk.mc, (M + GEMM_MR - 1) / GEMM_MR * GEMM_MR);
+    int ncMax = std::min(blk.nc, (N + GEMM_NR - 1) / GEMM_NR * GEMM_NR);
+    Acc* packedA = gemmPackBuffer<Acc>(0, (size_t)mcMax * kcMax);
+    Acc* packedB = gemmPackBuffer<Acc>(1, (size_t)kcMax * ncMax);
+
+    for (int jc = 0; jc < N; jc += blk.nc) {
+        int nb = std::min(blk.nc, N - jc);
+        for (int pc = 0; pc < K; pc += blk.kc) {
+            int kb = std::min(blk.kc, K - pc);
+            packB(B.block(pc, jc, kb, nb), packedB);
+            // El primer bloque de K sobrescribe C (salvo que se pida acumular)
+            bool acc = accumulate || pc > 0;
+            for (int ic = 0; ic < M; ic += blk.mc) {
+                int mb = std::min(blk.mc, M - ic);
+                packA(A.block(ic, pc, mb, kb), packedA);
+                macroKernel(mb, nb, kb, packedA, packedB, C.block(ic, jc, mb, nb), acc);
+            }
+        }
+    }
+}
+
+// C = A * B, o C += A * B si accumulate es true.
+template <typename T, typename Acc = T>
+void gemm(MatrixView<const T> A, MatrixView<const T> B, MatrixView<Acc> C, bool accumulate = false) {
+    gemmFused<T, Acc>(GemmOperand<T>(A), GemmOperand<T>(B), C, accumulate);
+}
+
+// Versión paralela: C se reparte en tiles de salida independientes.
+//  - Los tiles son múltiplos de MR filas y de NC columnas, así cada hilo
+//    empaqueta sus propios paneles (buffers por hilo) y conserva el reuso en caché.
+//  - Se prefiere partir por filas: cada hilo recibe una banda contigua de C
+//    (y de A), lo que mantiene su memoria local con la política first-touch en
+//    sistemas NUMA. Solo si no hay filas para todos se parte también por columnas.
+//  - Cada hilo recibe un rango contiguo y estático de tiles (una tarea por hilo).
+template <typename T, typename Acc = T>
+void gemmParallel(MatrixView<const T> A, MatrixView<const T> B, MatrixView<Acc> C, ThreadPool& pool,
+                  bool accumulate = false) {
+    int M = A.rows(), K = A.cols(), N = B.cols();
+    int threads = pool.size();
+    if (threads == 1 || (double)M * N * K < 64.0 * 64.0 * 64.0) {
+        gemm<T, Acc>(A, B, C, accumulate);
+        return;
+    }
+
+    const GemmBlocking& blk = gemmBlocking();
+    int rowSlivers = (M + GEMM_MR - 1) / GEMM_MR;
+    int colSlivers = (N + GEMM_NR - 1) / GEMM_NR;
+    int rowTiles = std::min(threads, rowSlivers);
+    int colTiles = std::max((N + blk.nc - 1) / blk.nc, (threads + rowTiles - 1) / rowTiles);
+    colTiles = std::min(colTiles, colSlivers);
+    int tileM = (rowSlivers + rowTiles - 1) / rowTiles * GEMM_MR;
+    int tileN = (colSlivers + colTiles - 1) / colTiles * GEMM_NR;
+    rowTiles = (M + tileM - 1) / tileM;
+    colTiles = (N + tileN - 1) / tileN;
+
+    int tiles = rowTiles * colTiles;
+    int tasks = std::min(threads, tiles);
+    TaskGroup group(pool);
+    for (int t = 0; t < tasks; t++) {
+        int first = (int)((long long)tiles * t / tasks);
+        int last = (int)((long long)tiles * (t + 1) / tasks);
+        group.run([=] {
+            for (int tile = first; tile < last; tile++) {
+                int i0 = tile / colTiles * tileM, j0 = tile % colTiles * tileN;
+                int mb = std::min(tileM, M - i0), nb = std::min(tileN, N - j0);
+                gemm<T, Acc>(A.block(i0, 0, mb, K), B.block(0, j0, K, nb), C.block(i0, j0, mb, nb), accumulate);
+            }
+        });
+    }
+    group.wait();
+}
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef MATRIX_HPP
+#define MATRIX_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "MemoryTracker.hpp"
+
+// Alineación de los buffers: una línea de caché (y el ancho de un registro AVX-512)
+constexpr size_t MATRIX_ALIGNMENT = 64;
+
+template <typename T>
+class MatrixView;
+
+// Expresiones elemento a elemento sobre matrices (MatrixExpr.hpp)
+template <typename E>
+class MatrixExpr;
+
+template <typename T, typename E>
+void assignMatrixExpr(MatrixView<T> out, const MatrixExpr<E>& e);
+
+// Vista no propietaria sobre una matriz almacenada por filas (row-major).
+// Solo guarda puntero, dimensiones y stride (leading dimension), por lo que
+// copiarla es gratis y permite trabajar con submatrices sin copiar datos.
+template <typename T>
+class MatrixView {
+public:
+    MatrixView() = default;
+    MatrixView(T* data, int rows, int cols, int stride)
+        : data_(data), rows_(rows), cols_(cols), stride_(stride) {}
+
+    // Permite pasar una vista mutable donde se espera una de solo lectura
+    template <typename U, typename = std::enable_if_t<std::is_same_v<const U, T>>>
+    MatrixView(const MatrixView<U>& other)
+        : data_(other.data()), rows_(other.rows()), cols_(other.cols()), stride_(other.stride()) {}
+
+    T* operator[](int i) const { return data_ + (size_t)i * stride_; }
+
+    // Escribe en los elementos de la vista una expresión (MatrixExpr.hpp),
+    // evaluada en una sola pasada. Asignar otra vista, en cambio, redirige esta.
+    template <typename E>
+    MatrixView& operator=(const MatrixExpr<E>& e) {
+        assignMatrixExpr<T>(*this, e);
+        return *this;
+    }
+
+    T* data() const { return data_; }
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    int stride() const { return stride_; }
+
+    // Submatriz de nrows x ncols que empieza en (row, col), sin copiar
+    MatrixView block(int row, int col, int nrows, int ncols) const {
+        return MatrixView(data_ + (size_t)row * stride_ + col, nrows, ncols, stride_);
+    }
+
+private:
+    T* data_ = nullptr;
+    int rows_ = 0;
+    int cols_ = 0;
+    int stride_ = 0;
+};
+
+// Matriz densa propietaria: un único buffer contiguo alineado a 64 bytes.
+// El stride se redondea para que cada fila empiece alineada a línea de caché.
+template <typename T>
+class Matrix {
+public:
+    Matrix() = default;
+
+    Matrix(int rows, int cols) : rows_(rows), cols_(cols), stride_(paddedStride(cols)) {
+        size_t bytes = this->bytes();
+        if (bytes == 0) return;
+        data_ = static_cast<T*>(alignedAllocate(MATRIX_ALIGNMENT, bytes)); // Contabilizada (MemoryTracker.hpp)
+        std::memset(data_, 0, bytes); // Inicializa la matriz con 0
+    }
+
+    Matrix(const Matrix& other) : Matrix(other.rows_, other.cols_) {
+        if (data_ != nullptr) std::memcpy(data_, other.data_, bytes());
+    }
+
+    Matrix(Matrix&& other) noexcept { swap(other); }
+
+    Matrix& operator=(Matrix other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    // Evalúa una expresión (MatrixExpr.hpp) sobre la matriz, que ya tiene su tamaño
+    template <typename E>
+    Matrix& operator=(const MatrixExpr<E>& e) {
+        assignMatrixExpr<T>(view(), e);
+        return *this;
+    }
+
+    ~Matrix() { alignedFree(data_, bytes()); }
+
+    void swap(Matrix& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(rows_, other.rows_);
+        std::swap(cols_, other.cols_);
+        std::swap(stride_, other.stride_);
+    }
+
+    T* operator[](int i) { return data_ + (size_t)i * stride_; }
+    const T* operator[](int i) const { return data_ + (size_t)i * stride_; }
+
+    MatrixView<T> view() { return MatrixView<T>(data_, rows_, cols_, stride_); }
+    MatrixView<const T> view() const { return MatrixView<const T>(data_, rows_, cols_, stride_); }
+    operator MatrixView<T>() { return view(); }
+    operator MatrixView<const T>() const { return view(); }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    int stride() const { return stride_; }
+
+    // Bytes reservados por el buffer (incluye el relleno de cada fila)
+    size_t bytes() const {
+        size_t raw = (size_t)rows_ * stride_ * sizeof(T);
+        return (raw + MATRIX_ALIGNMENT - 1) / MATRIX_ALIGNMENT * MATRIX_ALIGNMENT;
+    }
+
+    // Stride (en elementos) que mantiene alineado el inicio de cada fila
+    static int paddedStride(int cols) {
+        constexpr int perLine = MATRIX_ALIGNMENT % sizeof(T) == 0 ? (int)(MATRIX_ALIGNMENT / sizeof(T)) : 1;
+        return (cols + perLine - 1) / perLine * perLine;
+    }
+
+private:
+    T* data_ = nullptr;
+    int rows_ = 0;
+    int cols_ = 0;
+    int stride_ = 0;
+};
+
+#endif
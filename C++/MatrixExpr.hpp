@@ -0,0 +1,209 @@
+#ifndef MATRIX_EXPR_HPP
+#define MATRIX_EXPR_HPP
+
+#include <type_traits>
+#include <utility>
+
+#include "Matrix.hpp"
+#include "Simd.hpp"
+
+// Expresiones perezosas de sumas, restas y escalados de matrices:
+//
+//     C11 = P1 + P4 - P5 + P7; // Una pasada: C11[i][j] = P1[i][j] + ... + P7[i][j]
+//
+// Cada operador devuelve un nodo pequeño que guarda vistas de los operandos,
+// no copias: la expresión debe asignarse dentro de la misma expresión
+// completa en que se construye. Guardarla con auto y asignarla después solo
+// funciona si todas las matrices siguen vivas; con un temporal
+// (auto e = A + makeMatrix()) la vista queda colgando.
+//
+// La asignación a una MatrixView o Matrix recorre la salida una sola vez,
+// leyendo cada operando una vez y sin temporales. Encadenar
+// addMatrices/subtractMatrices, en cambio, lee y escribe la salida en cada
+// paso. Los operandos son MatrixView, Matrix u otras expresiones, todos con
+// el mismo tipo de elemento; las dimensiones se toman de la salida, como en
+// addMatrices. La salida puede ser uno de los operandos (C11 = C11 + P4),
+// pero no solaparse en parte con ninguno.
+//
+// El bucle se recorre en tramos de ancho fijo para que el compilador lo
+// vectorice, y se compila por ISA y se elige al arrancar, como SmallGemm.hpp.
+
+constexpr int MATRIX_EXPR_BLOCK = 16; // Elementos por tramo del bucle vectorizado
+
+#define MATRIX_EXPR_INLINE inline __attribute__((always_inline))
+
+template <typename E>
+class MatrixExpr {
+public:
+    const E& self() const { return static_cast<const E&>(*this); }
+};
+
+// Hoja: una matriz de solo lectura
+template <typename T>
+class MatrixTerm : public MatrixExpr<MatrixTerm<T>> {
+public:
+    using value_type = T;
+    static constexpr int operands = 1; // Matrices que lee la expresión
+
+    explicit MatrixTerm(MatrixView<const T> m) : m_(m) {}
+
+    // Evaluador de la fila i: operator()(j) da el elemento j
+    struct Row {
+        const T* p;
+        MATRIX_EXPR_INLINE T operator()(int j) const { return p[j]; }
+    };
+    Row row(int i) const { return Row{m_[i]}; }
+
+private:
+    MatrixView<const T> m_;
+};
+
+struct MatrixAddOp {
+    template <typename T>
+    static MATRIX_EXPR_INLINE T apply(T a, T b) { return a + b; }
+};
+
+struct MatrixSubOp {
+    template <typename T>
+    static MATRIX_EXPR_INLINE T apply(T a, T b) { return a - b; }
+};
+
+template <typename Op, typename L, typename R>
+class MatrixBinaryExpr : public MatrixExpr<MatrixBinaryExpr<Op, L, R>> {
+    static_assert(std::is_same_v<typename L::value_type, typename R::value_type>,
+                  "los operandos de una expresión deben tener el mismo tipo de elemento");
+
+public:
+    using value_type = typename L::value_type;
+    static constexpr int operands = L::operands + R::operands;
+
+    MatrixBinaryExpr(L l, R r) : l_(std::move(l)), r_(std::move(r)) {}
+
+    struct Row {
+        typename L::Row l;
+        typename R::Row r;
+        MATRIX_EXPR_INLINE value_type operator()(int j) const { return Op::apply(l(j), r(j)); }
+    };
+    Row row(int i) const { return Row{l_.row(i), r_.row(i)}; }
+
+private:
+    L l_;
+    R r_;
+};
+
+// alpha * e
+template <typename E>
+class MatrixScaledExpr : public MatrixExpr<MatrixScaledExpr<E>> {
+public:
+    using value_type = typename E::value_type;
+    static constexpr int operands = E::operands;
+
+    MatrixScaledExpr(value_type alpha, E e) : alpha_(alpha), e_(std::move(e)) {}
+
+    struct Row {
+        value_type alpha;
+        typename E::Row e;
+        MATRIX_EXPR_INLINE value_type operator()(int j) const { return alpha * e(j); }
+    };
+    Row row(int i) const { return Row{alpha_, e_.row(i)}; }
+
+private:
+    value_type alpha_;
+    E e_;
+};
+
+// --- Operandos y operadores ---
+
+template <typename T>
+MatrixTerm<std::remove_const_t<T>> asMatrixExpr(const MatrixView<T>& m) {
+    return MatrixTerm<std::remove_const_t<T>>(m);
+}
+
+template <typename T>
+MatrixTerm<T> asMatrixExpr(const Matrix<T>& m) {
+    return MatrixTerm<T>(m.view());
+}
+
+template <typename E>
+const E& asMatrixExpr(const MatrixExpr<E>& e) {
+    return e.self();
+}
+
+// Tipo de expresión de un operando (solo existe para matrices y expresiones)
+template <typename X>
+using MatrixExprOf = std::decay_t<decltype(asMatrixExpr(std::declval<const X&>()))>;
+
+template <typename L, typename R>
+MatrixBinaryExpr<MatrixAddOp, MatrixExprOf<L>, MatrixExprOf<R>> operator+(const L& l, const R& r) {
+    return {asMatrixExpr(l), asMatrixExpr(r)};
+}
+
+template <typename L, typename R>
+MatrixBinaryExpr<MatrixSubOp, MatrixExprOf<L>, MatrixExprOf<R>> operator-(const L& l, const R& r) {
+    return {asMatrixExpr(l), asMatrixExpr(r)};
+}
+
+// alpha se convierte al tipo de elemento: con elementos enteros no se admite
+// un escalar de coma flotante (0.5 * e daría 0 en silencio)
+template <typename S, typename X, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+MatrixScaledExpr<MatrixExprOf<X>> operator*(S alpha, const X& x) {
+    static_assert(std::is_floating_point_v<typename MatrixExprOf<X>::value_type> || std::is_integral_v<S>,
+                  "escalar de coma flotante con elementos enteros: alpha se truncaría");
+    return {typename MatrixExprOf<X>::value_type(alpha), asMatrixExpr(x)};
+}
+
+// --- Evaluación ---
+
+// Filas [first, last) de out = e. ivdep: la salida solo puede coincidir
+// exactamente con un operando, así que no hacen falta comprobaciones de solape
+template <typename T, typename E>
+MATRIX_EXPR_INLINE void assignMatrixExprBody(MatrixView<T> out, const E& e, int first, int last) {
+    constexpr int B = MATRIX_EXPR_BLOCK;
+    int cols = out.cols();
+    for (int i = first; i < last; i++) {
+        T* o = out[i];
+        typename E::Row row = e.row(i);
+        int j = 0;
+        for (; j + B <= cols; j += B) {
+#pragma GCC ivdep
+            for (int k = 0; k < B; k++) o[j + k] = row(j + k);
+        }
+        for (; j < cols; j++) o[j] = row(j);
+    }
+}
+
+template <typename T, typename E>
+void assignMatrixExprScalar(MatrixView<T> out, const E& e, int first, int last) {
+    assignMatrixExprBody<T, E>(out, e, first, last);
+}
+
+#ifdef SIMD_X86
+
+template <typename T, typename E>
+__attribute__((target("avx2"))) void assignMatrixExprAvx2(MatrixView<T> out, const E& e, int first, int last) {
+    assignMatrixExprBody<T, E>(out, e, first, last);
+}
+
+template <typename T, typename E>
+__attribute__((target("avx512f"))) void assignMatrixExprAvx512(MatrixView<T> out, const E& e, int first,
+                                                                int last) {
+    assignMatrixExprBody<T, E>(out, e, first, last);
+}
+
+#endif
+
+// out = e en una pasada, con el bucle del ISA elegido al arrancar
+template <typename T, typename E>
+void assignMatrixExpr(MatrixView<T> out, const MatrixExpr<E>& expr) {
+    static_assert(std::is_same_v<T, typename E::value_type>,
+                  "la salida debe tener el tipo de elemento de la expresión");
+    const E& e = expr.self();
+#ifdef SIMD_X86
+    SimdIsa isa = simdKernels().isa;
+    if (isa == SimdIsa::AVX512) return assignMatrixExprAvx512<T, E>(out, e, 0, out.rows());
+    if (isa >= SimdIsa::AVX2) return assignMatrixExprAvx2<T, E>(out, e, 0, out.rows());
+#endif
+    assignMatrixExprScalar<T, E>(out, e, 0, out.rows());
+}
+
+#endif
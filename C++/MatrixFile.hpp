@@ -0,0 +1,246 @@
+#ifndef MATRIX_FILE_HPP
+#define MATRIX_FILE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "Matrix.hpp"
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Archivo binario de matriz: cabecera de 64 bytes y, desde dataOffset
+// (múltiplo de página), las filas con el mismo stride alineado que Matrix.
+// Se usa proyectado en memoria (mmap): el contenido se lee bajo demanda por
+// páginas, así que una vista sobre el archivo no cuesta RAM hasta que se toca.
+
+constexpr char MATRIX_FILE_MAGIC[8] = {'M', 'A', 'T', 'R', 'I', 'X', 'B', 'N'};
+constexpr std::uint32_t MATRIX_FILE_VERSION = 1;
+constexpr std::uint64_t MATRIX_FILE_DATA_OFFSET = 4096;
+
+// Tipo de los elementos guardados
+enum class MatrixDtype : std::uint32_t { Int32 = 1, Int64 = 2, Float32 = 3, Float64 = 4 };
+
+inline const char* matrixDtypeName(MatrixDtype dtype) {
+    switch (dtype) {
+        case MatrixDtype::Int32: return "int32";
+        case MatrixDtype::Int64: return "int64";
+        case MatrixDtype::Float32: return "float";
+        case MatrixDtype::Float64: return "double";
+        default: return "desconocido";
+    }
+}
+
+template <typename T>
+constexpr MatrixDtype matrixDtypeOf() {
+    static_assert(std::is_same_v<T, std::int32_t> || std::is_same_v<T, std::int64_t> || std::is_same_v<T, float> ||
+                      std::is_same_v<T, double>,
+                  "tipo de elemento sin formato de archivo");
+    if constexpr (std::is_same_v<T, std::int32_t>) return MatrixDtype::Int32;
+    else if constexpr (std::is_same_v<T, std::int64_t>) return MatrixDtype::Int64;
+    else if constexpr (std::is_same_v<T, float>) return MatrixDtype::Float32;
+    else return MatrixDtype::Float64;
+}
+
+struct MatrixFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t dtype;       // MatrixDtype
+    std::uint32_t elementSize; // Bytes por elemento
+    std::uint32_t alignment;   // Alineación de cada fila en bytes
+    std::uint64_t rows;
+    std::uint64_t cols;
+    std::uint64_t stride;      // Elementos entre filas consecutivas (>= cols)
+    std::uint64_t dataOffset;  // Inicio de los datos desde el principio del archivo
+    unsigned char reserved[8];
+};
+static_assert(sizeof(MatrixFileHeader) == 64, "la cabecera ocupa 64 bytes");
+
+// Región de un archivo proyectada en memoria (solo POSIX). Lanza runtime_error
+// si no se puede abrir o proyectar.
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    // Abre un archivo existente entero, solo lectura o lectura/escritura
+    MappedFile(const std::string& path, bool writable) { map(path, 0, writable, false); }
+
+    // Crea (o trunca) un archivo de bytes bytes y lo proyecta para escritura
+    MappedFile(const std::string& path, size_t bytes) { map(path, bytes, true, true); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept { swap(other); }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~MappedFile() {
+#ifdef __unix__
+        if (data_ != nullptr) munmap(data_, size_);
+#endif
+    }
+
+    void swap(MappedFile& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+
+    unsigned char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    // Consejo al kernel sobre [offset, offset + bytes), ampliado a páginas
+    // completas: WILLNEED lanza la lectura anticipada sin bloquear y DONTNEED
+    // quita las páginas del proceso (siguen en la caché de páginas; las
+    // modificadas se escriben al archivo igualmente)
+    void advise(size_t offset, size_t bytes, int advice) const {
+#ifdef __unix__
+        if (data_ == nullptr || bytes == 0) return;
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        size_t first = offset / page * page;
+        size_t last = std::min(size_, (offset + bytes + page - 1) / page * page);
+        if (last > first) madvise(data_ + first, last - first, advice);
+#else
+        (void)offset, (void)bytes, (void)advice;
+#endif
+    }
+
+    // Escribe al archivo las páginas modificadas (bloqueante)
+    void flush() const {
+#ifdef __unix__
+        if (data_ != nullptr) msync(data_, size_, MS_SYNC);
+#endif
+    }
+
+private:
+    void map(const std::string& path, size_t bytes, bool writable, bool create) {
+#ifdef __unix__
+        int fd = ::open(path.c_str(), create ? O_RDWR | O_CREAT | O_TRUNC : (writable ? O_RDWR : O_RDONLY), 0644);
+        if (fd < 0) throw std::runtime_error("No se pudo abrir " + path);
+        if (create && ftruncate(fd, (off_t)bytes) != 0) {
+            ::close(fd);
+            throw std::runtime_error("No se pudo reservar espacio en " + path);
+        }
+        if (!create) {
+            struct stat st;
+            if (fstat(fd, &st) != 0) {
+                ::close(fd);
+                throw std::runtime_error("No se pudo leer el tamaño de " + path);
+            }
+            bytes = (size_t)st.st_size;
+        }
+        void* ptr = bytes ? mmap(nullptr, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0)
+                          : MAP_FAILED;
+        ::close(fd); // La proyección mantiene el archivo abierto
+        if (ptr == MAP_FAILED) throw std::runtime_error("No se pudo proyectar " + path);
+        data_ = static_cast<unsigned char*>(ptr);
+        size_ = bytes;
+#else
+        (void)bytes, (void)writable, (void)create;
+        throw std::runtime_error("Archivos proyectados no disponibles en esta plataforma: " + path);
+#endif
+    }
+
+    unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Matriz guardada en un archivo binario y proyectada en memoria. view() da
+// una MatrixView sobre el archivo sin copiar: sirve directamente al motor.
+template <typename T>
+class MappedMatrix {
+public:
+    MappedMatrix() = default;
+
+    // Abre un archivo existente; comprueba la cabecera y que el tipo sea T
+    static MappedMatrix open(const std::string& path, bool writable = false) {
+        MappedMatrix m;
+        m.file_ = MappedFile(path, writable);
+        if (m.file_.size() < sizeof(MatrixFileHeader)) throw std::runtime_error("Archivo de matriz truncado: " + path);
+        std::memcpy(&m.header_, m.file_.data(), sizeof(MatrixFileHeader));
+        const MatrixFileHeader& h = m.header_;
+        if (std::memcmp(h.magic, MATRIX_FILE_MAGIC, sizeof(h.magic)) != 0 || h.version != MATRIX_FILE_VERSION) {
+            throw std::runtime_error("No es un archivo de matriz válido: " + path);
+        }
+        if (h.dtype != (std::uint32_t)matrixDtypeOf<T>() || h.elementSize != sizeof(T)) {
+            throw std::runtime_error(std::string("El archivo ") + path + " guarda " +
+                                     matrixDtypeName((MatrixDtype)h.dtype) + ", se esperaba " +
+                                     matrixDtypeName(matrixDtypeOf<T>()));
+        }
+        if (h.stride < h.cols || h.dataOffset % alignof(T) != 0 || h.rows > (std::uint64_t)INT32_MAX ||
+            h.cols > (std::uint64_t)INT32_MAX || h.dataOffset + h.rows * h.stride * sizeof(T) > m.file_.size()) {
+            throw std::runtime_error("Cabecera inconsistente en " + path);
+        }
+        return m;
+    }
+
+    // Crea un archivo rows x cols (a 0) con el stride alineado de Matrix
+    static MappedMatrix create(const std::string& path, int rows, int cols) {
+        MatrixFileHeader h = {};
+        std::memcpy(h.magic, MATRIX_FILE_MAGIC, sizeof(h.magic));
+        h.version = MATRIX_FILE_VERSION;
+        h.dtype = (std::uint32_t)matrixDtypeOf<T>();
+        h.elementSize = sizeof(T);
+        h.alignment = MATRIX_ALIGNMENT;
+        h.rows = (std::uint64_t)rows;
+        h.cols = (std::uint64_t)cols;
+        h.stride = (std::uint64_t)Matrix<T>::paddedStride(cols);
+        h.dataOffset = MATRIX_FILE_DATA_OFFSET;
+
+        MappedMatrix m;
+        m.file_ = MappedFile(path, (size_t)(h.dataOffset + h.rows * h.stride * sizeof(T)));
+        std::memcpy(m.file_.data(), &h, sizeof(h));
+        m.header_ = h;
+        return m;
+    }
+
+    int rows() const { return (int)header_.rows; }
+    int cols() const { return (int)header_.cols; }
+    int stride() const { return (int)header_.stride; }
+
+    MatrixView<T> view() const {
+        return MatrixView<T>(reinterpret_cast<T*>(file_.data() + header_.dataOffset), rows(), cols(), stride());
+    }
+    operator MatrixView<T>() const { return view(); }
+    operator MatrixView<const T>() const { return view(); }
+
+    // Consejo (MADV_*) sobre el bloque nrows x ncols que empieza en (row, col).
+    // Las filas contiguas en el archivo se agrupan en una sola llamada.
+    void adviseBlock(int row, int col, int nrows, int ncols, int advice) const {
+        size_t rowBytes = (size_t)header_.stride * sizeof(T);
+        size_t base = header_.dataOffset + (size_t)row * rowBytes + (size_t)col * sizeof(T);
+        size_t bytes = (size_t)ncols * sizeof(T);
+        if (ncols == cols() || nrows == 1) {
+            file_.advise(base, (size_t)(nrows - 1) * rowBytes + bytes, advice);
+            return;
+        }
+        for (int i = 0; i < nrows; i++) file_.advise(base + (size_t)i * rowBytes, bytes, advice);
+    }
+
+    void flush() const { file_.flush(); }
+
+    // true si la cabecera del archivo ya no es la leída al abrirlo (otro
+    // proceso lo recreó con otras dimensiones o tipo sobre la proyección)
+    bool headerChanged() const {
+        return file_.data() == nullptr || std::memcmp(file_.data(), &header_, sizeof(header_)) != 0;
+    }
+
+private:
+    MappedFile file_;
+    MatrixFileHeader header_ = {};
+};
+
+#endif
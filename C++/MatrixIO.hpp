@@ -0,0 +1,200 @@
+#ifndef MATRIX_IO_HPP
+#define MATRIX_IO_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "Matrix.hpp"
+#include "MatrixFile.hpp"
+
+// Entrada y salida de matrices para los programas: carga desde archivo (el
+// formato binario de MatrixFile.hpp se proyecta sin copiar; el texto se
+// importa), guardado en binario o texto según la extensión y volcado de texto
+// con buffer propio en lugar de un cout por elemento.
+
+// true si path termina en ext
+inline bool hasExtension(const std::string& path, const char* ext) {
+    size_t n = std::strlen(ext);
+    return path.size() >= n && path.compare(path.size() - n, n, ext) == 0;
+}
+
+// Archivos de texto por extensión (.txt, .csv); el resto se trata como binario
+inline bool isTextMatrixPath(const std::string& path) {
+    return hasExtension(path, ".txt") || hasExtension(path, ".csv");
+}
+
+// true si el archivo empieza con la firma del formato binario
+inline bool isBinaryMatrixFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(MATRIX_FILE_MAGIC)] = {};
+    in.read(magic, sizeof(magic));
+    return in && std::memcmp(magic, MATRIX_FILE_MAGIC, sizeof(magic)) == 0;
+}
+
+// --- Texto ---
+
+inline bool isTextSeparator(char c) { return c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r'; }
+
+// Valores de la línea [p, end) (hasta el salto de línea), sin interpretarlos
+inline int countTextValues(const char* p, const char* end) {
+    int count = 0;
+    while (p < end) {
+        while (p < end && isTextSeparator(*p)) p++;
+        if (p == end) break;
+        count++;
+        while (p < end && !isTextSeparator(*p)) p++;
+    }
+    return count;
+}
+
+// Importa una matriz de texto: una fila por línea, valores separados por
+// espacios, tabuladores, comas o ';'. Se ignoran las líneas vacías y las que
+// empiezan por '#'. El archivo se lee proyectado y se recorre dos veces: la
+// primera cuenta filas y columnas (para reservar la matriz una sola vez) y la
+// segunda convierte con from_chars, sin flujos ni locale.
+template <typename T>
+Matrix<T> importTextMatrix(const std::string& path) {
+    MappedFile file(path, false);
+    const char* begin = reinterpret_cast<const char*>(file.data());
+    const char* end = begin + file.size();
+
+    // Recorre las líneas con datos: visit(fila, inicio, fin, número de línea)
+    auto forEachRow = [&](auto visit) {
+        int row = 0, line = 0;
+        for (const char* p = begin; p < end;) {
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', (size_t)(end - p)));
+            if (eol == nullptr) eol = end;
+            line++;
+            const char* q = p;
+            while (q < eol && isTextSeparator(*q)) q++;
+            if (q < eol && *q != '#') visit(row++, q, eol, line);
+            p = eol + 1;
+        }
+        return row;
+    };
+
+    int cols = -1;
+    int rows = forEachRow([&](int, const char* p, const char* eol, int line) {
+        int n = countTextValues(p, eol);
+        if (cols < 0) cols = n;
+        if (n != cols) {
+            throw std::runtime_error(path + ": la línea " + std::to_string(line) + " tiene " + std::to_string(n) +
+                                     " valores, se esperaban " + std::to_string(cols));
+        }
+    });
+
+    Matrix<T> m(rows, std::max(cols, 0));
+    forEachRow([&](int row, const char* p, const char* eol, int line) {
+        T* out = m[row];
+        for (int j = 0; j < cols; j++) {
+            while (isTextSeparator(*p)) p++;
+            if (*p == '+') p++;
+            std::from_chars_result r = std::from_chars(p, eol, out[j]);
+            if (r.ec != std::errc() || (r.ptr < eol && !isTextSeparator(*r.ptr))) {
+                throw std::runtime_error(path + ": valor no válido en la línea " + std::to_string(line));
+            }
+            p = r.ptr;
+        }
+    });
+    return m;
+}
+
+// Escribe m como texto (una fila por línea, valores separados por sep). Las
+// cifras se forman con to_chars en un buffer de 64 KB que se vuelca entero a
+// out: sin endl por fila, así que el flujo no se vacía en cada línea.
+template <typename T>
+void writeMatrixText(std::ostream& out, MatrixView<const T> m, char sep = '\t') {
+    constexpr size_t BUFFER = 64 * 1024;
+    constexpr size_t MAX_VALUE = 64; // Margen para un valor y su separador
+    char buffer[BUFFER];
+    size_t used = 0;
+    for (int i = 0; i < m.rows(); i++) {
+        const T* row = m[i];
+        for (int j = 0; j < m.cols(); j++) {
+            if (used + MAX_VALUE > BUFFER) {
+                out.write(buffer, (std::streamsize)used);
+                used = 0;
+            }
+            char* p = std::to_chars(buffer + used, buffer + BUFFER, row[j]).ptr;
+            *p++ = j + 1 < m.cols() ? sep : '\n';
+            used = (size_t)(p - buffer);
+        }
+    }
+    out.write(buffer, (std::streamsize)used);
+}
+
+// Imprime una matriz con su nombre y dimensiones, con el volcado de writeMatrixText
+template <typename T>
+void printMatrix(std::ostream& out, MatrixView<const T> m, const std::string& name) {
+    if (m.rows() <= 0 || m.cols() <= 0) {
+        out << "Matriz " << name << " no es válida o está vacía.\n";
+        return;
+    }
+    out << "Matriz " << name << " (" << m.rows() << "x" << m.cols() << "):\n";
+    writeMatrixText<T>(out, m);
+    out << "\n";
+}
+
+// --- Carga y guardado ---
+
+// Guarda m en path: texto si la extensión es .txt (espacios) o .csv (comas),
+// si no, el formato binario de MatrixFile.hpp
+template <typename T>
+void saveMatrix(const std::string& path, MatrixView<const T> m) {
+    if (isTextMatrixPath(path)) {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) throw std::runtime_error("No se pudo abrir " + path);
+        writeMatrixText<T>(out, m, hasExtension(path, ".csv") ? ',' : ' ');
+        if (!out) throw std::runtime_error("Error al escribir " + path);
+        return;
+    }
+    MappedMatrix<T> file = MappedMatrix<T>::create(path, m.rows(), m.cols());
+    MatrixView<T> dst = file.view();
+    for (int i = 0; i < m.rows(); i++) std::memcpy(dst[i], m[i], (size_t)m.cols() * sizeof(T));
+    file.flush();
+}
+
+// Matriz de entrada de solo lectura: proyectada desde un archivo binario (sin
+// copia: view() apunta al archivo y las páginas se leen al usarlas) o propia
+// (importada de texto, o generada por el programa).
+template <typename T>
+class MatrixSource {
+public:
+    MatrixSource() = default;
+    explicit MatrixSource(Matrix<T>&& owned) : owned_(std::move(owned)) {}
+
+    // Binario si el archivo lleva la firma del formato; si no, texto
+    static MatrixSource load(const std::string& path) {
+        MatrixSource source;
+        if (isBinaryMatrixFile(path)) {
+            source.mapped_ = MappedMatrix<T>::open(path);
+            source.isMapped_ = true;
+        } else {
+            source.owned_ = importTextMatrix<T>(path);
+        }
+        return source;
+    }
+
+    MatrixView<const T> view() const {
+        return isMapped_ ? MatrixView<const T>(mapped_.view()) : MatrixView<const T>(owned_.view());
+    }
+    operator MatrixView<const T>() const { return view(); }
+
+    int rows() const { return view().rows(); }
+    int cols() const { return view().cols(); }
+    bool mapped() const { return isMapped_; }
+
+private:
+    Matrix<T> owned_;
+    MappedMatrix<T> mapped_;
+    bool isMapped_ = false;
+};
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef MEMORY_TRACKER_HPP
+#define MEMORY_TRACKER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef __unix__
+#include <sys/resource.h>
+#endif
+
+// Contabilidad de memoria real de los buffers del motor: toda reserva de
+// Matrix y de las arenas (Workspace) pasa por alignedAllocate/alignedFree,
+// que llevan bytes vivos, pico y número de reservas. Los contadores son
+// atómicos, así que las reservas de los hilos del pool también cuentan.
+
+struct MemoryStats {
+    size_t liveBytes = 0;      // Bytes reservados ahora
+    size_t peakBytes = 0;      // Máximo de liveBytes desde el último resetPeak
+    size_t allocations = 0;    // Reservas desde el arranque
+    size_t allocatedBytes = 0; // Bytes reservados desde el arranque (sin restar liberaciones)
+};
+
+class MemoryTracker {
+public:
+    static MemoryTracker& instance() {
+        static MemoryTracker tracker;
+        return tracker;
+    }
+
+    void onAllocate(size_t bytes) {
+        size_t live = live_.fetch_add(bytes) + bytes;
+        size_t peak = peak_.load();
+        while (live > peak && !peak_.compare_exchange_weak(peak, live)) {
+        }
+        allocations_.fetch_add(1);
+        allocated_.fetch_add(bytes);
+    }
+
+    void onFree(size_t bytes) { live_.fetch_sub(bytes); }
+
+    // El pico vuelve a los bytes vivos actuales (inicio de una medición)
+    void resetPeak() { peak_.store(live_.load()); }
+
+    MemoryStats stats() const {
+        MemoryStats s;
+        s.liveBytes = live_.load();
+        s.peakBytes = peak_.load();
+        s.allocations = allocations_.load();
+        s.allocatedBytes = allocated_.load();
+        return s;
+    }
+
+private:
+    std::atomic<size_t> live_{0};
+    std::atomic<size_t> peak_{0};
+    std::atomic<size_t> allocations_{0};
+    std::atomic<size_t> allocated_{0};
+};
+
+// Reserva alineada y contabilizada; lanza bad_alloc si no hay memoria.
+// bytes debe ser múltiplo de alignment (requisito de aligned_alloc).
+inline void* alignedAllocate(size_t alignment, size_t bytes) {
+    void* ptr = std::aligned_alloc(alignment, bytes);
+    if (ptr == nullptr) throw std::bad_alloc();
+    MemoryTracker::instance().onAllocate(bytes);
+    return ptr;
+}
+
+// Libera un buffer de alignedAllocate; bytes es el tamaño con que se reservó
+inline void alignedFree(void* ptr, size_t bytes) {
+    if (ptr == nullptr) return;
+    std::free(ptr);
+    MemoryTracker::instance().onFree(bytes);
+}
+
+// --- RSS del proceso (para contrastar con la contabilidad) ---
+
+// Pico de memoria residente del proceso según getrusage (0 si no disponible)
+inline size_t peakRssBytes() {
+#ifdef __unix__
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return (size_t)usage.ru_maxrss; // macOS lo da en bytes
+#else
+    return (size_t)usage.ru_maxrss * 1024; // Linux, en KB
+#endif
+#else
+    return 0;
+#endif
+}
+
+// Reinicia el pico de RSS (Linux >= 4.0, escribiendo 5 en /proc/self/clear_refs).
+// false si no se pudo: el pico de getrusage es entonces el de toda la ejecución.
+inline bool resetPeakRss() {
+#ifdef __linux__
+    std::FILE* f = std::fopen("/proc/self/clear_refs", "w");
+    if (f == nullptr) return false;
+    bool ok = std::fputs("5", f) >= 0;
+    return std::fclose(f) == 0 && ok;
+#else
+    return false;
+#endif
+}
+
+// Resultado de una medición de memoria
+struct MemoryReport {
+    size_t baselineBytes = 0; // Bytes vivos al empezar (p. ej. A y B)
+    size_t peakBytes = 0;     // Pico de bytes vivos durante la medición
+    size_t liveBytes = 0;     // Bytes vivos al terminar (p. ej. + C)
+    size_t allocations = 0;   // Reservas hechas durante la medición
+    size_t peakRss = 0;       // Pico de RSS (getrusage)
+    bool rssReset = false;    // true si el pico de RSS se reinició al empezar
+
+    // Memoria extra que necesitó la región por encima de lo que ya estaba vivo
+    size_t peakExtraBytes() const { return peakBytes - baselineBytes; }
+};
+
+// Mide la memoria de una región (p. ej. una multiplicación): se crea justo
+// antes y finish() devuelve pico, reservas y RSS. No anidar mediciones (el
+// pico es global).
+class MemoryMeasurement {
+public:
+    MemoryMeasurement() {
+        MemoryTracker& tracker = MemoryTracker::instance();
+        tracker.resetPeak();
+        start_ = tracker.stats();
+        rssReset_ = resetPeakRss();
+    }
+
+    MemoryReport finish() const {
+        MemoryStats now = MemoryTracker::instance().stats();
+        MemoryReport r;
+        r.baselineBytes = start_.liveBytes;
+        r.peakBytes = now.peakBytes;
+        r.liveBytes = now.liveBytes;
+        r.allocations = now.allocations - start_.allocations;
+        r.peakRss = peakRssBytes();
+        r.rssReset = rssReset_;
+        return r;
+    }
+
+private:
+    MemoryStats start_;
+    bool rssReset_ = false;
+};
+
+#endif
@@ -1,122 +1,237 @@
-#include <iostream>
-#include <vector>
-#include <cstdlib> // Para rand, srand
-#include <ctime>   // Para clock, time
-#include <chrono>  // Para medir el tiempo en C++
-
-using namespace std;
-
-// Función para asignar memoria para una matriz cuadrada usando std::vector
-vector<vector<int>> allocateMatrix(int size) {
-    if (size < 0) return {}; // Evitar tamaño negativo
-    return vector<vector<int>>(size, vector<int>(size, 0)); // Inicializa una matriz NxN con 0
-}
-
-// Función para llenar una matriz cuadrada con números aleatorios (0-9)
-void fillRandomMatrix(int size, vector<vector<int>>& matrix) {
-    if (size <= 0) return;
-    for (int i = 0; i < size; i++) {
-        for (int j = 0; j < size; j++) {
-            matrix[i][j] = rand() % 10; // Números aleatorios entre 0 y 9
-        }
-    }
-}
-
-// Función para imprimir una matriz cuadrada
-void printMatrix(int size, const vector<vector<int>>& matrix, const string& name) {
-    if (size <= 0) {
-        cout << "Matriz " << name << " no es válida o está vacía.\n";
-        return;
-    }
-    cout << "Matriz " << name << " (" << size << "x" << size << "):\n";
-    for (int i = 0; i < size; i++) {
-        for (int j = 0; j < size; j++) {
-            cout << matrix[i][j] << "\t";
-        }
-        cout << endl;
-    }
-    cout << endl;
-}
-
-// Algoritmo Clásico (Naive) para multiplicar dos matrices cuadradas
-vector<vector<int>> naive_multiply(int size, const vector<vector<int>>& matrixA, const vector<vector<int>>& matrixB) {
-    if (size == 0) return allocateMatrix(0);
-    vector<vector<int>> matrixC = allocateMatrix(size);
-
-    for (int i = 0; i < size; i++) {
-        for (int j = 0; j < size; j++) {
-            matrixC[i][j] = 0;
-            for (int k = 0; k < size; k++) {
-                matrixC[i][j] += matrixA[i][k] * matrixB[k][j];
-            }
-        }
-    }
-    return matrixC;
-}
-
-int main() {
-    int size;
-    srand(time(NULL)); // Sembrar el generador de números aleatorios
-
-    cout << "ALGORITMO NAIVE PARA MULTIPLICACIÓN DE MATRICES\n";
-    cout << "-----------------------------------------------------------\n";
-    cout << "Ingrese el tamaño N para las matrices cuadradas (NxN): ";
-    if (!(cin >> size)) {
-        cout << "Entrada inválida.\n";
-        return 1;
-    }
-
-    if (size < 0) { // El caso size == 0 se maneja en las funciones
-        cout << "El tamaño de la matriz no puede ser negativo.\n";
-        return 1;
-    }
-
-    if (size == 0) {
-        cout << "Se solicitó un tamaño de matriz de 0. No se realizarán operaciones.\n";
-        cout << "Tiempo de CPU para la multiplicación: 0.000000 segundos\n";
-        cout << "Memoria estimada utilizada por las matrices A, B y C: 0 bytes (0.00 KB / 0.00 MB)\n";
-        return 0;
-    }
-
-    // Asignar matrices A y B
-    vector<vector<int>> matrixA = allocateMatrix(size);
-    vector<vector<int>> matrixB = allocateMatrix(size);
-
-    // Llenar las matrices con valores aleatorios
-    fillRandomMatrix(size, matrixA);
-    fillRandomMatrix(size, matrixB);
-
-    // Mostrar las matrices si el tamaño es menor o igual a 10
-    if (size <= 10) {
-        printMatrix(size, matrixA, "A");
-        printMatrix(size, matrixB, "B");
-    } else {
-        cout << "Matrices A y B generadas (" << size << "x" << size << "). No se imprimirán debido a su tamaño.\n\n";
-    }
-
-    // Medir el tiempo de ejecución
-    auto startTime = chrono::high_resolution_clock::now();
-    vector<vector<int>> matrixC = naive_multiply(size, matrixA, matrixB);
-    auto endTime = chrono::high_resolution_clock::now();
-
-    // Calcular el tiempo de ejecución
-    chrono::duration<double> cpu_time_used = endTime - startTime;
-
-    // Calcular la memoria utilizada (en bytes)
-    size_t memory_used_bytes = 3 * (size * sizeof(int*) + size * size * sizeof(int));
-
-    // Mostrar el resultado
-    cout << "Multiplicación (naive) completada.\n";
-    if (size <= 10) {
-        printMatrix(size, matrixC, "Resultante C (A x B)");
-    } else {
-        cout << "Matriz Resultante C (" << size << "x" << size << ") calculada. No se imprimirá debido a su tamaño.\n\n";
-    }
-
-    cout << "--- Métricas de Rendimiento (Algoritmo Ingenuo) ---\n";
-    cout << "Tiempo de CPU para la multiplicación: " << cpu_time_used.count() << " segundos\n";
-    cout << "Memoria estimada utilizada por las matrices A, B y C: " << memory_used_bytes << " bytes ("
-         << (double)memory_used_bytes / 1024.0 << " KB / " << (double)memory_used_bytes / (1024.0 * 1024.0) << " MB)\n";
-
-    return 0;
-}
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>   // Para time (semilla por defecto)
+#include <chrono>  // Para medir el tiempo en C++
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+
+#include "ElementType.hpp"
+#include "Gemm.hpp"
+#include "Matrix.hpp"
+#include "MatrixIO.hpp"
+#include "MemoryTracker.hpp"
+#include "RandomMatrix.hpp"
+#include "ThreadPool.hpp"
+#include "Verify.hpp"
+
+using namespace std;
+
+// Función para asignar memoria para una matriz cuadrada (buffer contiguo y alineado)
+template <typename T>
+Matrix<T> allocateMatrix(int size) {
+    if (size < 0) return {}; // Evitar tamaño negativo
+    return Matrix<T>(size, size); // Inicializa una matriz NxN con 0
+}
+
+// Algoritmo Clásico (Naive) para multiplicar dos matrices cuadradas.
+// Mismo número de operaciones O(n³), pero ejecutado con el motor por bloques
+// (paneles empaquetados + microkernel) para aprovechar la caché, repartido
+// por tiles de salida entre los hilos del pool.
+// Acepta matrices rectangulares: A (M x K) * B (K x N) = C (M x N).
+// Los elementos son T y el resultado se acumula en Acc (p. ej. int32 -> int64).
+template <typename T, typename Acc = T>
+Matrix<Acc> naive_multiply(int M, int K, int N, MatrixView<const T> matrixA, MatrixView<const T> matrixB) {
+    Matrix<Acc> matrixC(M, N);
+    gemmParallel<T, Acc>(matrixA.block(0, 0, M, K), matrixB.block(0, 0, K, N), matrixC, defaultThreadPool());
+    return matrixC;
+}
+
+template <typename T, typename Acc = T>
+Matrix<Acc> naive_multiply(int size, MatrixView<const T> matrixA, MatrixView<const T> matrixB) {
+    if (size == 0) return allocateMatrix<Acc>(0);
+    return naive_multiply<T, Acc>(size, size, size, matrixA, matrixB);
+}
+
+// Reporte de escalabilidad: repite la multiplicación con 1, 2, 4, ... hasta
+// maxThreads hilos e imprime tiempo, aceleración y eficiencia paralela.
+template <typename T, typename Acc>
+void printScalingReport(MatrixView<const T> matrixA, MatrixView<const T> matrixB, int maxThreads) {
+    int M = matrixA.rows(), K = matrixA.cols(), N = matrixB.cols();
+    cout << "--- Escalabilidad (naive por bloques, " << M << "x" << K << "x" << N << ") ---\n";
+    cout << "Hilos\tTiempo (s)\tAceleración\tEficiencia\n";
+    double baseTime = 0.0;
+    for (int threads = 1;; threads = min(threads * 2, maxThreads)) {
+        setDefaultThreadCount(threads);
+        naive_multiply<T, Acc>(M, K, N, matrixA, matrixB); // Calentamiento (hilos y buffers)
+        auto start = chrono::steady_clock::now();
+        naive_multiply<T, Acc>(M, K, N, matrixA, matrixB);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        if (threads == 1) baseTime = elapsed.count();
+        double speedup = baseTime / elapsed.count();
+        cout << threads << "\t" << elapsed.count() << "\t" << speedup << "x\t\t" << speedup / threads * 100.0 << "%\n";
+        if (threads == maxThreads) break;
+    }
+    cout << endl;
+}
+
+// Obtiene A y B (de los archivos de inputs o aleatorias de size x size con la
+// semilla seed), las multiplica y reporta métricas con elementos T y
+// acumulación Acc; guarda C en output si se indicó y, con verifyRounds > 0,
+// comprueba C con Freivalds (Verify.hpp)
+template <typename T, typename Acc>
+int runNaive(int size, ElementType type, bool scaling, int maxThreads, const vector<string>& inputs,
+             const string& output, uint64_t seed, int verifyRounds) {
+    MatrixSource<T> matrixA, matrixB;
+    if (inputs.empty()) {
+        // Asignar matrices A y B y llenarlas con valores aleatorios (0-9, en paralelo)
+        Matrix<T> randomA = allocateMatrix<T>(size);
+        Matrix<T> randomB = allocateMatrix<T>(size);
+        fillRandomMatrix<T>(randomA.view(), seed, 0);
+        fillRandomMatrix<T>(randomB.view(), seed, 1);
+        cout << "Semilla de A y B: " << seed << "\n";
+        matrixA = MatrixSource<T>(std::move(randomA));
+        matrixB = MatrixSource<T>(std::move(randomB));
+    } else {
+        // Archivos binarios proyectados sin copia, o texto importado
+        matrixA = MatrixSource<T>::load(inputs[0]);
+        matrixB = MatrixSource<T>::load(inputs[1]);
+        if (matrixA.cols() != matrixB.rows()) {
+            cout << "Dimensiones incompatibles: A es " << matrixA.rows() << "x" << matrixA.cols() << " y B es "
+                 << matrixB.rows() << "x" << matrixB.cols() << ".\n";
+            return 1;
+        }
+    }
+    int M = matrixA.rows(), K = matrixA.cols(), N = matrixB.cols();
+    bool small = max(M, max(K, N)) <= 10;
+
+    // Mostrar las matrices si todas sus dimensiones son menores o iguales a 10
+    if (small) {
+        printMatrix<T>(cout, matrixA, "A");
+        printMatrix<T>(cout, matrixB, "B");
+    } else {
+        cout << "Matrices A (" << M << "x" << K << ") y B (" << K << "x" << N << ") "
+             << (inputs.empty() ? "generadas" : "cargadas") << ". No se imprimirán debido a su tamaño.\n\n";
+    }
+
+    // Medir el tiempo de ejecución y la memoria (MemoryTracker.hpp)
+    MemoryMeasurement memory;
+    auto startTime = chrono::high_resolution_clock::now();
+    Matrix<Acc> matrixC = naive_multiply<T, Acc>(M, K, N, matrixA, matrixB);
+    auto endTime = chrono::high_resolution_clock::now();
+    MemoryReport mem = memory.finish();
+
+    // Calcular el tiempo de ejecución
+    chrono::duration<double> cpu_time_used = endTime - startTime;
+
+    // Memoria medida: pico de bytes vivos (A, B, C y buffers de empaquetado)
+    size_t memory_used_bytes = mem.peakBytes;
+
+    // Mostrar el resultado
+    cout << "Multiplicación (naive) completada.\n";
+    if (small) {
+        printMatrix<Acc>(cout, matrixC, "Resultante C (A x B)");
+    } else {
+        cout << "Matriz Resultante C (" << M << "x" << N << ") calculada. No se imprimirá debido a su tamaño.\n\n";
+    }
+    if (!output.empty()) {
+        saveMatrix<Acc>(output, matrixC);
+        cout << "Matriz C guardada en " << output << "\n\n";
+    }
+
+    cout << "--- Métricas de Rendimiento (Algoritmo Ingenuo) ---\n";
+    cout << "Kernel SIMD: " << simdIsaName(simdKernels().isa) << "\n";
+    cout << "Hilos: " << defaultThreadPool().size() << "\n";
+    cout << "Tipo de elemento: " << elementTypeName(type) << "\n";
+    cout << "Tiempo de CPU para la multiplicación: " << cpu_time_used.count() << " segundos\n";
+    cout << "Memoria utilizada (pico medido): " << memory_used_bytes << " bytes ("
+         << (double)memory_used_bytes / 1024.0 << " KB / " << (double)memory_used_bytes / (1024.0 * 1024.0) << " MB)\n";
+    cout << "Reservas durante la multiplicación: " << mem.allocations << "\n";
+    cout << (mem.rssReset ? "RSS máximo durante la multiplicación (getrusage): " : "RSS máximo del proceso (getrusage): ")
+         << (double)mem.peakRss / (1024.0 * 1024.0) << " MB\n";
+
+    if (verifyRounds > 0) {
+        auto verifyStart = chrono::steady_clock::now();
+        VerifyReport check = freivaldsVerify<T, Acc>(matrixA, matrixB, matrixC, verifyRounds, seed);
+        chrono::duration<double, milli> verifyTime = chrono::steady_clock::now() - verifyStart;
+        printVerifyReport(cout, check, verifyTime.count());
+        if (!check.ok) return 1;
+    }
+
+    if (scaling) {
+        cout << "\n";
+        printScalingReport<T, Acc>(matrixA, matrixB, maxThreads);
+    }
+
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    // Opciones: --threads N (hilos; por defecto MATMUL_THREADS o todos los núcleos)
+    //           --scaling   (reporte de escalabilidad de 1 a N hilos)
+    //           --type T    (int32, int32-acc64, int64, float, double; ver ElementType.hpp)
+    //           --input A B (lee A y B de archivos en lugar de generarlas; ver MatrixIO.hpp)
+    //           --output C  (guarda el resultado: .txt/.csv como texto, si no en binario)
+    //           --seed S    (semilla de A y B aleatorias; por defecto, la hora)
+    //           --verify [R] (comprueba C con R rondas de Freivalds; por defecto 2)
+    bool scaling = false;
+    ElementType type = ElementType::Int32;
+    vector<string> inputs;
+    string output;
+    uint64_t seed = (uint64_t)time(NULL);
+    int verifyRounds = 0;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            setDefaultThreadCount(atoi(argv[++i]));
+        } else if (arg == "--scaling") {
+            scaling = true;
+        } else if (arg == "--type" && i + 1 < argc) {
+            if (!parseElementType(argv[++i], type)) {
+                cout << "Tipo no válido: " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (arg == "--input" && i + 2 < argc) {
+            inputs = {argv[i + 1], argv[i + 2]};
+            i += 2;
+        } else if (arg == "--output" && i + 1 < argc) {
+            output = argv[++i];
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--verify") {
+            // Número de rondas opcional
+            verifyRounds = (i + 1 < argc && isdigit((unsigned char)argv[i + 1][0])) ? atoi(argv[++i])
+                                                                                   : VERIFY_DEFAULT_ROUNDS;
+        }
+    }
+    int maxThreads = defaultThreadCount();
+
+    // Lanza la multiplicación con el tipo elegido; los errores de archivo se informan
+    auto run = [&](int size) {
+        try {
+            return dispatchElementType(type, [&](auto t, auto acc) {
+                return runNaive<decltype(t), decltype(acc)>(size, type, scaling, maxThreads, inputs, output, seed, verifyRounds);
+            });
+        } catch (const exception& e) {
+            cout << e.what() << "\n";
+            return 1;
+        }
+    };
+
+    int size;
+
+    cout << "ALGORITMO NAIVE PARA MULTIPLICACIÓN DE MATRICES\n";
+    cout << "-----------------------------------------------------------\n";
+    if (!inputs.empty()) return run(0);
+    cout << "Ingrese el tamaño N para las matrices cuadradas (NxN): ";
+    if (!(cin >> size)) {
+        cout << "Entrada inválida.\n";
+        return 1;
+    }
+
+    if (size < 0) { // El caso size == 0 se maneja en las funciones
+        cout << "El tamaño de la matriz no puede ser negativo.\n";
+        return 1;
+    }
+
+    if (size == 0) {
+        cout << "Se solicitó un tamaño de matriz de 0. No se realizarán operaciones.\n";
+        cout << "Tiempo de CPU para la multiplicación: 0.000000 segundos\n";
+        cout << "Memoria utilizada (pico medido): 0 bytes (0.00 KB / 0.00 MB)\n";
+        return 0;
+    }
+
+    return run(size);
+}
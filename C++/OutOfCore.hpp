@@ -0,0 +1,175 @@
+#ifndef OUT_OF_CORE_HPP
+#define OUT_OF_CORE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <stdexcept>
+
+#include "Gemm.hpp"
+#include "Matrix.hpp"
+#include "MatrixFile.hpp"
+#include "Strassen.hpp"
+#include "ThreadPool.hpp"
+#include "Workspace.hpp"
+
+#ifdef __unix__
+#include <sys/mman.h>
+#endif
+
+// Multiplicación fuera de memoria: A y B se leen de archivos proyectados
+// (MatrixFile.hpp) y C se escribe en otro, tile a tile. En RAM solo viven los
+// tiles en curso (copias de A(i,k), B(k,j), el acumulador C(i,j) y la arena de
+// Strassen), con tamaño elegido para caber en un presupuesto fijo: el pico de
+// RSS depende del presupuesto, no de N. Cada tile del archivo se suelta
+// (DONTNEED) tras copiarlo, y el siguiente se pide por adelantado (WILLNEED)
+// para que el kernel lo lea mientras se calcula el actual.
+
+#define OUT_OF_CORE_BUDGET_MB 256 // Presupuesto por defecto (MB)
+
+// Presupuesto en uso: MATMUL_OOC_BUDGET_MB del entorno o el valor por defecto
+inline size_t& outOfCoreBudget() {
+    static size_t budget = [] {
+        const char* v = std::getenv("MATMUL_OOC_BUDGET_MB");
+        long mb = v != nullptr ? std::atol(v) : 0;
+        return (size_t)(mb > 0 ? mb : OUT_OF_CORE_BUDGET_MB) * 1024 * 1024;
+    }();
+    return budget;
+}
+
+// Memoria de trabajo para tiles t x t: copias de A y B (T), acumulador y
+// producto parcial (Acc) y la arena de Strassen para el producto de un tile
+template <typename T, typename Acc>
+size_t outOfCoreTileBytes(int t) {
+    return Workspace::matrixBytes<T>(t, t) * 2 + Workspace::matrixBytes<Acc>(t, t) * 2 +
+           strassen_workspace_size<T, Acc>(t);
+}
+
+// Mayor lado de tile (múltiplo de 64, o la matriz entera si es menor) cuya
+// memoria de trabajo cabe en 3/4 del presupuesto; el resto queda para las
+// páginas del archivo que se tocan al copiar un tile y los buffers del motor.
+template <typename T, typename Acc>
+int outOfCoreTileSize(int M, int K, int N, size_t budget) {
+    int largest = std::max(M, std::max(K, N));
+    int t = 64;
+    while (t < largest && outOfCoreTileBytes<T, Acc>(std::min(largest, t * 2)) <= budget / 4 * 3) t *= 2;
+    while (t + 64 < largest && outOfCoreTileBytes<T, Acc>(t + 64) <= budget / 4 * 3) t += 64;
+    return std::min(t, largest);
+}
+
+struct OutOfCoreReport {
+    int tile = 0;          // Lado del tile usado
+    size_t tileBytes = 0;  // Memoria de trabajo reservada para los tiles
+    long long tiles = 0;   // Productos de tile calculados
+};
+
+// Filas que se copian entre el archivo y un tile antes de soltar sus páginas.
+// Un fallo de página proyecta también páginas vecinas (fault-around, folios
+// grandes), de otros tiles de las mismas filas: por eso se sueltan las filas
+// completas, y por franjas para que no lleguen a estar todas proyectadas a la vez
+constexpr int OUT_OF_CORE_BAND_ROWS = 32;
+
+// Copia el bloque (row, col) de src a dst por franjas de filas
+template <typename T>
+void loadTile(const MappedMatrix<T>& src, int row, int col, MatrixView<T> dst) {
+    for (int i = 0; i < dst.rows(); i += OUT_OF_CORE_BAND_ROWS) {
+        int rows = std::min(OUT_OF_CORE_BAND_ROWS, dst.rows() - i);
+        copyMatrix<T>(src.view().block(row + i, col, rows, dst.cols()), dst.block(i, 0, rows, dst.cols()));
+#ifdef __unix__
+        src.adviseBlock(row + i, 0, rows, src.cols(), MADV_DONTNEED);
+#endif
+    }
+}
+
+// Escritura del tile src en el bloque (row, col) de dst, por franjas como loadTile
+template <typename T>
+void storeTile(MatrixView<T> src, const MappedMatrix<T>& dst, int row, int col) {
+    for (int i = 0; i < src.rows(); i += OUT_OF_CORE_BAND_ROWS) {
+        int rows = std::min(OUT_OF_CORE_BAND_ROWS, src.rows() - i);
+        copyMatrix<T>(src.block(i, 0, rows, src.cols()), dst.view().block(row + i, col, rows, src.cols()));
+#ifdef __unix__
+        dst.adviseBlock(row + i, 0, rows, dst.cols(), MADV_DONTNEED);
+#endif
+    }
+}
+
+// C = A * B con A, B y C en archivos proyectados. C debe existir con las
+// dimensiones del resultado (MappedMatrix<Acc>::create). Usa el pool por
+// defecto dentro de cada tile (Strassen o motor por bloques según el tamaño).
+template <typename T, typename Acc = T>
+OutOfCoreReport outOfCoreMultiply(const MappedMatrix<T>& A, const MappedMatrix<T>& B, const MappedMatrix<Acc>& C,
+                                  size_t budget = outOfCoreBudget()) {
+    int M = A.rows(), K = A.cols(), N = B.cols();
+    if (B.rows() != K || C.rows() != M || C.cols() != N) {
+        throw std::runtime_error("Dimensiones incompatibles en la multiplicación fuera de memoria");
+    }
+    OutOfCoreReport report;
+    int t = outOfCoreTileSize<T, Acc>(M, K, N, budget);
+    report.tile = t;
+
+    // Arena para el mayor de los productos de tile (los de borde son más pequeños)
+    size_t wsBytes = 0;
+    for (int m : {std::min(t, M), M % t}) {
+        for (int k : {std::min(t, K), K % t}) {
+            for (int n : {std::min(t, N), N % t}) {
+                if (m > 0 && k > 0 && n > 0) wsBytes = std::max(wsBytes, strassen_workspace_size<T, Acc>(m, k, n));
+            }
+        }
+    }
+    Workspace ws(wsBytes);
+    Matrix<T> tileA(t, t), tileB(t, t);
+    Matrix<Acc> tileC(t, t), partial(t, t);
+    report.tileBytes = tileA.bytes() + tileB.bytes() + tileC.bytes() + partial.bytes() + wsBytes;
+
+    // Recorrido (i, j, k): cada tile de C se completa antes de pasar al siguiente
+    struct Step {
+        int i, j, k;
+    };
+    auto next = [&](Step s) {
+        if ((s.k += t) < K) return s;
+        s.k = 0;
+        if ((s.j += t) < N) return s;
+        s.j = 0;
+        s.i += t;
+        return s;
+    };
+    auto prefetch = [&](Step s) {
+#ifdef __unix__
+        if (s.i >= M) return;
+        A.adviseBlock(s.i, s.k, std::min(t, M - s.i), std::min(t, K - s.k), MADV_WILLNEED);
+        B.adviseBlock(s.k, s.j, std::min(t, K - s.k), std::min(t, N - s.j), MADV_WILLNEED);
+#else
+        (void)s;
+#endif
+    };
+
+    prefetch({0, 0, 0});
+    for (Step s = {0, 0, 0}; s.i < M; s = next(s)) {
+        int mb = std::min(t, M - s.i), kb = std::min(t, K - s.k), nb = std::min(t, N - s.j);
+        MatrixView<T> a = tileA.view().block(0, 0, mb, kb), b = tileB.view().block(0, 0, kb, nb);
+        MatrixView<Acc> c = tileC.view().block(0, 0, mb, nb);
+        loadTile(A, s.i, s.k, a);
+        loadTile(B, s.k, s.j, b);
+        prefetch(next(s));
+
+        // C(i,j) += A(i,k) * B(k,j); el primer k escribe directamente
+        if (strassen_is_base(mb, kb, nb)) {
+            gemmParallel<T, Acc>(a, b, c, defaultThreadPool(), s.k > 0);
+        } else if (s.k == 0) {
+            strassen_multiply<T, Acc>(a, b, c, ws);
+        } else {
+            MatrixView<Acc> p = partial.view().block(0, 0, mb, nb);
+            strassen_multiply<T, Acc>(a, b, p, ws);
+            addMatrices<Acc>(c, p, c);
+        }
+        report.tiles++;
+
+        if (s.k + t >= K) { // Tile de C terminado: al archivo y fuera del proceso
+            storeTile(c, C, s.i, s.j);
+        }
+    }
+    C.flush();
+    return report;
+}
+
+#endif
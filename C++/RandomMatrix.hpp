@@ -0,0 +1,144 @@
+#ifndef RANDOM_MATRIX_HPP
+#define RANDOM_MATRIX_HPP
+
+#include <algorithm>
+#include <cstdint>
+
+#include "Matrix.hpp"
+#include "Simd.hpp"
+#include "ThreadPool.hpp"
+
+// Matrices aleatorias (enteros 0-9) generadas en paralelo y reproducibles:
+// cada valor sale de Philox4x32-10, un generador basado en contador (Salmon
+// et al., "Parallel random numbers: as easy as 1, 2, 3"), aplicado a
+// (fila, bloque de 4 columnas, flujo) con la semilla como clave. No hay
+// estado que avanzar, así que el valor de (i, j) es el mismo con cualquier
+// número de hilos o reparto de filas. Los contadores de un lote son
+// independientes y el bucle se vectoriza (productos 32x32 -> 64 por carril);
+// el cuerpo se compila por ISA y se elige al arrancar, como SmallGemm.hpp.
+
+constexpr int RANDOM_MATRIX_RANGE = 10;  // Valores en [0, RANDOM_MATRIX_RANGE)
+constexpr int RANDOM_FILL_COUNTERS = 16; // Contadores por lote (64 valores)
+
+#define RANDOM_FILL_INLINE inline __attribute__((always_inline))
+
+// 10 rondas de Philox4x32 sobre n contadores a la vez (x[palabra][contador])
+template <int n>
+RANDOM_FILL_INLINE void philox4x32Rounds(uint32_t (&x)[4][n], uint32_t k0, uint32_t k1) {
+    constexpr uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u; // Multiplicadores
+    constexpr uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u; // Incremento de la clave
+    for (int round = 0; round < 10; round++) {
+        for (int c = 0; c < n; c++) {
+            uint64_t p0 = (uint64_t)M0 * x[0][c], p1 = (uint64_t)M1 * x[2][c];
+            uint32_t y0 = (uint32_t)(p1 >> 32) ^ x[1][c] ^ k0;
+            uint32_t y2 = (uint32_t)(p0 >> 32) ^ x[3][c] ^ k1;
+            x[0][c] = y0;
+            x[1][c] = (uint32_t)p1;
+            x[2][c] = y2;
+            x[3][c] = (uint32_t)p0;
+        }
+        k0 += W0;
+        k1 += W1;
+    }
+}
+
+// Filas [first, last) de m; la fila local i es la fila firstRow + i de la
+// matriz lógica (para llenar por franjas una matriz mayor, p. ej. un archivo)
+template <typename T>
+RANDOM_FILL_INLINE void randomFillBody(MatrixView<T> m, uint64_t seed, uint32_t stream, int firstRow, int first,
+                                       int last) {
+    constexpr int B = RANDOM_FILL_COUNTERS;
+    uint32_t k0 = (uint32_t)seed, k1 = (uint32_t)(seed >> 32);
+    int cols = m.cols();
+    for (int i = first; i < last; i++) {
+        T* row = m[i];
+        for (int j0 = 0; j0 < cols; j0 += 4 * B) {
+            uint32_t x[4][B];
+            for (int c = 0; c < B; c++) {
+                x[0][c] = (uint32_t)(j0 / 4 + c); // Contador: (bloque de columnas, fila, flujo, 0)
+                x[1][c] = (uint32_t)(firstRow + i);
+                x[2][c] = stream;
+                x[3][c] = 0;
+            }
+            philox4x32Rounds<B>(x, k0, k1);
+            // La palabra w del contador c va a la columna j0 + w * B + c (escritura
+            // contigua), escalada a [0, RANGE) sin módulo: (x * RANGE) >> 32
+            T* out = row + j0;
+            if (j0 + 4 * B <= cols) {
+                for (int w = 0; w < 4; w++) {
+                    for (int c = 0; c < B; c++) out[w * B + c] = T(((uint64_t)x[w][c] * RANDOM_MATRIX_RANGE) >> 32);
+                }
+            } else {
+                for (int e = 0; e < cols - j0; e++) {
+                    out[e] = T(((uint64_t)x[e / B][e % B] * RANDOM_MATRIX_RANGE) >> 32);
+                }
+            }
+        }
+    }
+}
+
+// n palabras de 32 bits sin escalar de (seed, stream), p. ej. para vectores
+// aleatorios. La palabra 3 del contador vale 1: no coinciden con las de
+// fillRandomMatrix aunque se use la misma semilla.
+inline void randomWords(uint32_t* out, int n, uint64_t seed, uint32_t stream) {
+    for (int j0 = 0; j0 < n; j0 += 4) {
+        uint32_t x[4][1] = {{(uint32_t)(j0 / 4)}, {0}, {stream}, {1}};
+        philox4x32Rounds<1>(x, (uint32_t)seed, (uint32_t)(seed >> 32));
+        for (int w = 0; w < 4 && j0 + w < n; w++) out[j0 + w] = x[w][0];
+    }
+}
+
+template <typename T>
+using RandomFillKernel = void (*)(MatrixView<T>, uint64_t, uint32_t, int, int, int);
+
+template <typename T>
+void randomFillScalar(MatrixView<T> m, uint64_t seed, uint32_t stream, int firstRow, int first, int last) {
+    randomFillBody<T>(m, seed, stream, firstRow, first, last);
+}
+
+#ifdef SIMD_X86
+
+template <typename T>
+__attribute__((target("avx2"))) void randomFillAvx2(MatrixView<T> m, uint64_t seed, uint32_t stream,
+                                                    int firstRow, int first, int last) {
+    randomFillBody<T>(m, seed, stream, firstRow, first, last);
+}
+
+template <typename T>
+__attribute__((target("avx512f,avx512dq"))) void randomFillAvx512(MatrixView<T> m, uint64_t seed,
+                                                                  uint32_t stream, int firstRow, int first,
+                                                                  int last) {
+    randomFillBody<T>(m, seed, stream, firstRow, first, last);
+}
+
+#endif
+
+template <typename T>
+RandomFillKernel<T> randomFillKernel() {
+    static const RandomFillKernel<T> kernel = [] {
+#ifdef SIMD_X86
+        SimdIsa isa = simdKernels().isa;
+        if (isa == SimdIsa::AVX512 && __builtin_cpu_supports("avx512dq")) return randomFillAvx512<T>;
+        if (isa >= SimdIsa::AVX2) return randomFillAvx2<T>;
+#endif
+        return randomFillScalar<T>;
+    }();
+    return kernel;
+}
+
+// Llena m con enteros 0-9 de la semilla seed. stream separa matrices con la
+// misma semilla (p. ej. A = 0, B = 1); firstRow es la fila lógica de m[0].
+// Las filas se reparten entre los hilos del pool en tramos de al menos ~64K
+// valores; el contenido no depende de ese reparto.
+template <typename T>
+void fillRandomMatrix(MatrixView<T> m, uint64_t seed, uint32_t stream, ThreadPool& pool, int firstRow = 0) {
+    RandomFillKernel<T> kernel = randomFillKernel<T>();
+    parallelRows(pool, m.rows(), m.cols(), [=](int first, int last) { kernel(m, seed, stream, firstRow, first, last); });
+}
+
+template <typename T>
+void fillRandomMatrix(MatrixView<T> m, uint64_t seed, uint32_t stream = 0, int firstRow = 0) {
+    fillRandomMatrix<T>(m, seed, stream, defaultThreadPool(), firstRow);
+}
+
+#endif
@@ -0,0 +1,544 @@
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// Kernels vectoriales para int32 (SSE4.1 / AVX2 / AVX-512), float/double
+// (AVX2+FMA / AVX-512) e int64 (AVX2 / AVX-512DQ) elegidos al arrancar según
+// CPUID, de modo que un mismo binario use el mejor ISA de cada máquina. Cada
+// función se compila con su atributo target, sin flags globales (-mavx2...).
+// La versión escalar se mantiene como referencia y como respaldo portable.
+
+constexpr int GEMM_MR = 6;  // Filas del tile de registros del microkernel
+constexpr int GEMM_NR = 16; // Columnas del tile (16 int32 = un zmm o dos ymm)
+
+enum class SimdIsa { Scalar, SSE41, AVX2, AVX512 };
+
+inline const char* simdIsaName(SimdIsa isa) {
+    switch (isa) {
+        case SimdIsa::SSE41: return "SSE4.1";
+        case SimdIsa::AVX2: return "AVX2";
+        case SimdIsa::AVX512: return "AVX-512";
+        default: return "Escalar";
+    }
+}
+
+// Escribe (o suma) las primeras mr x nr posiciones de un tile MR x NR en C
+template <typename T>
+void storeTile(const T* tile, T* c, int ldc, int mr, int nr, bool accumulate) {
+    for (int i = 0; i < mr; i++) {
+        T* row = c + (size_t)i * ldc;
+        const T* t = tile + i * GEMM_NR;
+        if (accumulate) {
+            for (int j = 0; j < nr; j++) row[j] += t[j];
+        } else {
+            for (int j = 0; j < nr; j++) row[j] = t[j];
+        }
+    }
+}
+
+// Microkernel escalar: tile MR x NR sobre paneles empaquetados (ver Gemm.hpp).
+// mr/nr < MR/NR solo en los bordes de la matriz.
+template <typename T>
+void microKernelScalar(int kb, const T* a, const T* b, T* c, int ldc, int mr, int nr, bool accumulate) {
+    T acc[GEMM_MR * GEMM_NR] = {};
+    for (int k = 0; k < kb; k++) {
+        for (int i = 0; i < GEMM_MR; i++) {
+            const T aik = a[i];
+            for (int j = 0; j < GEMM_NR; j++) {
+                acc[i * GEMM_NR + j] += aik * b[j];
+            }
+        }
+        a += GEMM_MR;
+        b += GEMM_NR;
+    }
+    storeTile(acc, c, ldc, mr, nr, accumulate);
+}
+
+template <typename T>
+void addRowScalar(int n, const T* a, const T* b, T* c) {
+    for (int j = 0; j < n; j++) c[j] = a[j] + b[j];
+}
+
+template <typename T>
+void subRowScalar(int n, const T* a, const T* b, T* c) {
+    for (int j = 0; j < n; j++) c[j] = a[j] - b[j];
+}
+
+#ifdef SIMD_X86
+
+// --- SSE4.1: 4 int32 por registro; el tile se recorre en dos mitades de 8 columnas
+// para que los 12 acumuladores quepan en los 16 registros xmm ---
+
+__attribute__((target("sse4.1")))
+inline void microKernelInt32Sse41(int kb, const int* a, const int* b, int* c, int ldc, int mr, int nr, bool accumulate) {
+    alignas(64) int tile[GEMM_MR * GEMM_NR];
+    for (int half = 0; half < 2; half++) {
+        __m128i acc[GEMM_MR][2];
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++) acc[i][0] = acc[i][1] = _mm_setzero_si128();
+        const int* ap = a;
+        const int* bp = b + half * 8;
+        for (int k = 0; k < kb; k++) {
+            __m128i b0 = _mm_loadu_si128((const __m128i*)bp);
+            __m128i b1 = _mm_loadu_si128((const __m128i*)(bp + 4));
+#pragma GCC unroll 8
+            for (int i = 0; i < GEMM_MR; i++) {
+                __m128i ai = _mm_set1_epi32(ap[i]);
+                acc[i][0] = _mm_add_epi32(acc[i][0], _mm_mullo_epi32(ai, b0));
+                acc[i][1] = _mm_add_epi32(acc[i][1], _mm_mullo_epi32(ai, b1));
+            }
+            ap += GEMM_MR;
+            bp += GEMM_NR;
+        }
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++) {
+            _mm_store_si128((__m128i*)(tile + i * GEMM_NR + half * 8), acc[i][0]);
+            _mm_store_si128((__m128i*)(tile + i * GEMM_NR + half * 8 + 4), acc[i][1]);
+        }
+    }
+    storeTile(tile, c, ldc, mr, nr, accumulate);
+}
+
+__attribute__((target("sse4.1")))
+inline void addInt32Sse41(int n, const int* a, const int* b, int* c) {
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + j));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + j));
+        _mm_storeu_si128((__m128i*)(c + j), _mm_add_epi32(va, vb));
+    }
+    for (; j < n; j++) c[j] = a[j] + b[j];
+}
+
+__attribute__((target("sse4.1")))
+inline void subInt32Sse41(int n, const int* a, const int* b, int* c) {
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + j));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + j));
+        _mm_storeu_si128((__m128i*)(c + j), _mm_sub_epi32(va, vb));
+    }
+    for (; j < n; j++) c[j] = a[j] - b[j];
+}
+
+// --- AVX2: 8 int32 por registro, 6 x 2 acumuladores ymm ---
+
+__attribute__((target("avx2")))
+inline void microKernelInt32Avx2(int kb, const int* a, const int* b, int* c, int ldc, int mr, int nr, bool accumulate) {
+    __m256i acc[GEMM_MR][2];
+#pragma GCC unroll 8
+    for (int i = 0; i < GEMM_MR; i++) acc[i][0] = acc[i][1] = _mm256_setzero_si256();
+    for (int k = 0; k < kb; k++) {
+        __m256i b0 = _mm256_loadu_si256((const __m256i*)b);
+        __m256i b1 = _mm256_loadu_si256((const __m256i*)(b + 8));
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++) {
+            __m256i ai = _mm256_set1_epi32(a[i]);
+            acc[i][0] = _mm256_add_epi32(acc[i][0], _mm256_mullo_epi32(ai, b0));
+            acc[i][1] = _mm256_add_epi32(acc[i][1], _mm256_mullo_epi32(ai, b1));
+        }
+        a += GEMM_MR;
+        b += GEMM_NR;
+    }
+    if (mr == GEMM_MR && nr == GEMM_NR) {
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++) {
+            __m256i* row = (__m256i*)(c + (size_t)i * ldc);
+            if (accumulate) {
+                acc[i][0] = _mm256_add_epi32(acc[i][0], _mm256_loadu_si256(row));
+                acc[i][1] = _mm256_add_epi32(acc[i][1], _mm256_loadu_si256(row + 1));
+            }
+            _mm256_storeu_si256(row, acc[i][0]);
+            _mm256_storeu_si256(row + 1, acc[i][1]);
+        }
+        return;
+    }
+    alignas(64) int tile[GEMM_MR * GEMM_NR];
+#pragma GCC unroll 8
+    for (int i = 0; i < GEMM_MR; i++) {
+        _mm256_store_si256((__m256i*)(tile + i * GEMM_NR), acc[i][0]);
+        _mm256_store_si256((__m256i*)(tile + i * GEMM_NR + 8), acc[i][1]);
+    }
+    storeTile(tile, c, ldc, mr, nr, accumulate);
+}
+
+__attribute__((target("avx2")))
+inline void addInt32Avx2(int n, const int* a, const int* b, int* c) {
+    int j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + j));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + j));
+        _mm256_storeu_si256((__m256i*)(c + j), _mm256_add_epi32(va, vb));
+    }
+    for (; j < n; j++) c[j] = a[j] + b[j];
+}
+
+__attribute__((target("avx2")))
+inline void subInt32Avx2(int n, const int* a, const int* b, int* c) {
+    int j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + j));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + j));
+        _mm256_storeu_si256((__m256i*)(c + j), _mm256_sub_epi32(va, vb));
+    }
+    for (; j < n; j++) c[j] = a[j] - b[j];
+}
+
+// --- AVX-512: una fila del tile (16 int32) por registro zmm ---
+
+__attribute__((target("avx512f")))
+inline void microKernelInt32Avx512(int kb, const int* a, const int* b, int* c, int ldc, int mr, int nr, bool accumulate) {
+    __m512i acc[GEMM_MR];
+#pragma GCC unroll 8
+    for (int i = 0; i < GEMM_MR; i++) acc[i] = _mm512_setzero_si512();
+    for (int k = 0; k < kb; k++) {
+        __m512i b0 = _mm512_loadu_si512(b);
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++) {
+            acc[i] = _mm512_add_epi32(acc[i], _mm512_mullo_epi32(_mm512_set1_epi32(a[i]), b0));
+        }
+        a += GEMM_MR;
+        b += GEMM_NR;
+    }
+    if (mr == GEMM_MR) {
+        // Las columnas sobrantes del borde se enmascaran en la carga/escritura
+        __mmask16 mask = (__mmask16)((1u << nr) - 1);
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++) {
+            int* row = c + (size_t)i * ldc;
+            if (accumulate) acc[i] = _mm512_add_epi32(acc[i], _mm512_maskz_loadu_epi32(mask, row));
+            _mm512_mask_storeu_epi32(row, mask, acc[i]);
+        }
+        return;
+    }
+    alignas(64) int tile[GEMM_MR * GEMM_NR];
+#pragma GCC unroll 8
+    for (int i = 0; i < GEMM_MR; i++) _mm512_store_si512(tile + i * GEMM_NR, acc[i]);
+    storeTile(tile, c, ldc, mr, nr, accumulate);
+}
+
+__attribute__((target("avx512f")))
+inline void addInt32Avx512(int n, const int* a, const int* b, int* c) {
+    int j = 0;
+    for (; j + 16 <= n; j += 16) {
+        _mm512_storeu_si512(c + j, _mm512_add_epi32(_mm512_loadu_si512(a + j), _mm512_loadu_si512(b + j)));
+    }
+    if (j < n) {
+        __mmask16 mask = (__mmask16)((1u << (n - j)) - 1);
+        __m512i va = _mm512_maskz_loadu_epi32(mask, a + j);
+        __m512i vb = _mm512_maskz_loadu_epi32(mask, b + j);
+        _mm512_mask_storeu_epi32(c + j, mask, _mm512_add_epi32(va, vb));
+    }
+}
+
+__attribute__((target("avx512f")))
+inline void subInt32Avx512(int n, const int* a, const int* b, int* c) {
+    int j = 0;
+    for (; j + 16 <= n; j += 16) {
+        _mm512_storeu_si512(c + j, _mm512_sub_epi32(_mm512_loadu_si512(a + j), _mm512_loadu_si512(b + j)));
+    }
+    if (j < n) {
+        __mmask16 mask = (__mmask16)((1u << (n - j)) - 1);
+        __m512i va = _mm512_maskz_loadu_epi32(mask, a + j);
+        __m512i vb = _mm512_maskz_loadu_epi32(mask, b + j);
+        _mm512_mask_storeu_epi32(c + j, mask, _mm512_sub_epi32(va, vb));
+    }
+}
+
+// --- float / double: mismo tile MR x NR y mismo formato de paneles que int32 ---
+
+// AVX2 + FMA, float: 8 por registro, 6 x 2 acumuladores ymm
+__attribute__((target("avx2,fma")))
+inline void microKernelFloatAvx2(int kb, const float* a, const float* b, float* c, int ldc, int mr, int nr,
+                                 bool accumulate) {
+    __m256 acc[GEMM_MR][2];
+#pragma GCC unroll 8
+    for (int i = 0; i < GEMM_MR; i++) acc[i][0] = acc[i][1] = _mm256_setzero_ps();
+    for (int k = 0; k < kb; k++) {
+        __m256 b0 = _mm256_loadu_ps(b);
+        __m256 b1 = _mm256_loadu_ps(b + 8);
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++) {
+            __m256 ai = _mm256_broadcast_ss(a + i);
+            acc[i][0] = _mm256_fmadd_ps(ai, b0, acc[i][0]);
+            acc[i][1] = _mm256_fmadd_ps(ai, b1, acc[i][1]);
+        }
+        a += GEMM_MR;
+        b += GEMM_NR;
+    }
+    alignas(64) float tile[GEMM_MR * GEMM_NR];
+#pragma GCC unroll 8
+    for (int i = 0; i < GEMM_MR; i++) {
+        _mm256_store_ps(tile + i * GEMM_NR, acc[i][0]);
+        _mm256_store_ps(tile + i * GEMM_NR + 8, acc[i][1]);
+    }
+    storeTile(tile, c, ldc, mr, nr, accumulate);
+}
+
+// AVX2 + FMA, double: 4 por registro; el tile se recorre en dos mitades de 8
+// columnas para que los 12 acumuladores quepan en los 16 registros ymm
+__attribute__((target("avx2,fma")))
+inline void microKernelDoubleAvx2(int kb, const double* a, const double* b, double* c, int ldc, int mr, int nr,
+                                  bool accumulate) {
+    alignas(64) double tile[GEMM_MR * GEMM_NR];
+    for (int half = 0; half < 2; half++) {
+        __m256d acc[GEMM_MR][2];
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++) acc[i][0] = acc[i][1] = _mm256_setzero_pd();
+        const double* ap = a;
+        const double* bp = b + half * 8;
+        for (int k = 0; k < kb; k++) {
+            __m256d b0 = _mm256_loadu_pd(bp);
+            __m256d b1 = _mm256_loadu_pd(bp + 4);
+#pragma GCC unroll 8
+            for (int i = 0; i < GEMM_MR; i++) {
+                __m256d ai = _mm256_broadcast_sd(ap + i);
+                acc[i][0] = _mm256_fmadd_pd(ai, b0, acc[i][0]);
+                acc[i][1] = _mm256_fmadd_pd(ai, b1, acc[i][1]);
+            }
+            ap += GEMM_MR;
+            bp += GEMM_NR;
+        }
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++) {
+            _mm256_store_pd(tile + i * GEMM_NR + half * 8, acc[i][0]);
+            _mm256_store_pd(tile + i * GEMM_NR + half * 8 + 4, acc[i][1]);
+        }
+    }
+    storeTile(tile, c, ldc, mr, nr, accumulate);
+}
+
+// AVX-512, float: una fila del tile (16 float) por registro zmm
+__attribute__((target("avx512f")))
+inline void microKernelFloatAvx512(int kb, const float* a, const float* b, float* c, int ldc, int mr, int nr,
+                                   bool accumulate) {
+    __m512 acc[GEMM_MR];
+#pragma GCC unroll 8
+    for (int i = 0; i < GEMM_MR; i++) acc[i] = _mm512_setzero_ps();
+    for (int k = 0; k < kb; k++) {
+        __m512 b0 = _mm512_loadu_ps(b);
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++) acc[i] = _mm512_fmadd_ps(_mm512_set1_ps(a[i]), b0, acc[i]);
+        a += GEMM_MR;
+        b += GEMM_NR;
+    }
+    if (mr == GEMM_MR) {
+        __mmask16 mask = (__mmask16)((1u << nr) - 1);
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++) {
+            float* row = c + (size_t)i * ldc;
+            if (accumulate) acc[i] = _mm512_add_ps(acc[i], _mm512_maskz_loadu_ps(mask, row));
+            _mm512_mask_storeu_ps(row, mask, acc[i]);
+        }
+        return;
+    }
+    alignas(64) float tile[GEMM_MR * GEMM_NR];
+#pragma GCC unroll 8
+    for (int i = 0; i < GEMM_MR; i++) _mm512_store_ps(tile + i * GEMM_NR, acc[i]);
+    storeTile(tile, c, ldc, mr, nr, accumulate);
+}
+
+// AVX-512, double: 8 por registro, 6 x 2 acumuladores zmm
+__attribute__((target("avx512f")))
+inline void microKernelDoubleAvx512(int kb, const double* a, const double* b, double* c, int ldc, int mr, int nr,
+                                    bool accumulate) {
+    __m512d acc[GEMM_MR][2];
+#pragma GCC unroll 8
+    for (int i = 0; i < GEMM_MR; i++) acc[i][0] = acc[i][1] = _mm512_setzero_pd();
+    for (int k = 0; k < kb; k++) {
+        __m512d b0 = _mm512_loadu_pd(b);
+        __m512d b1 = _mm512_loadu_pd(b + 8);
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++) {
+            __m512d ai = _mm512_set1_pd(a[i]);
+            acc[i][0] = _mm512_fmadd_pd(ai, b0, acc[i][0]);
+            acc[i][1] = _mm512_fmadd_pd(ai, b1, acc[i][1]);
+        }
+        a += GEMM_MR;
+        b += GEMM_NR;
+    }
+    if (mr == GEMM_MR) {
+        __mmask8 lo = (__mmask8)(nr >= 8 ? 0xFF : (1u << nr) - 1);
+        __mmask8 hi = (__mmask8)(nr > 8 ? (1u << (nr - 8)) - 1 : 0);
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++) {
+            double* row = c + (size_t)i * ldc;
+            if (accumulate) {
+                acc[i][0] = _mm512_add_pd(acc[i][0], _mm512_maskz_loadu_pd(lo, row));
+                acc[i][1] = _mm512_add_pd(acc[i][1], _mm512_maskz_loadu_pd(hi, row + 8));
+            }
+            _mm512_mask_storeu_pd(row, lo, acc[i][0]);
+            _mm512_mask_storeu_pd(row + 8, hi, acc[i][1]);
+        }
+        return;
+    }
+    alignas(64) double tile[GEMM_MR * GEMM_NR];
+#pragma GCC unroll 8
+    for (int i = 0; i < GEMM_MR; i++) {
+        _mm512_store_pd(tile + i * GEMM_NR, acc[i][0]);
+        _mm512_store_pd(tile + i * GEMM_NR + 8, acc[i][1]);
+    }
+    storeTile(tile, c, ldc, mr, nr, accumulate);
+}
+
+// --- int64: AVX2 no tiene producto de 64 bits; se arma con tres productos
+// 32x32->64 (la parte alta x alta no afecta a los 64 bits bajos) ---
+
+__attribute__((target("avx2")))
+inline __m256i mullo64Avx2(__m256i a, __m256i b) {
+    __m256i lo = _mm256_mul_epu32(a, b);
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                     _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+}
+
+// AVX2, int64: 4 por registro; dos mitades de 8 columnas como en double
+__attribute__((target("avx2")))
+inline void microKernelInt64Avx2(int kb, const std::int64_t* a, const std::int64_t* b, std::int64_t* c, int ldc,
+                                 int mr, int nr, bool accumulate) {
+    alignas(64) std::int64_t tile[GEMM_MR * GEMM_NR];
+    for (int half = 0; half < 2; half++) {
+        __m256i acc[GEMM_MR][2];
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++) acc[i][0] = acc[i][1] = _mm256_setzero_si256();
+        const std::int64_t* ap = a;
+        const std::int64_t* bp = b + half * 8;
+        for (int k = 0; k < kb; k++) {
+            __m256i b0 = _mm256_loadu_si256((const __m256i*)bp);
+            __m256i b1 = _mm256_loadu_si256((const __m256i*)(bp + 4));
+#pragma GCC unroll 8
+            for (int i = 0; i < GEMM_MR; i++) {
+                __m256i ai = _mm256_set1_epi64x(ap[i]);
+                acc[i][0] = _mm256_add_epi64(acc[i][0], mullo64Avx2(ai, b0));
+                acc[i][1] = _mm256_add_epi64(acc[i][1], mullo64Avx2(ai, b1));
+            }
+            ap += GEMM_MR;
+            bp += GEMM_NR;
+        }
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++) {
+            _mm256_store_si256((__m256i*)(tile + i * GEMM_NR + half * 8), acc[i][0]);
+            _mm256_store_si256((__m256i*)(tile + i * GEMM_NR + half * 8 + 4), acc[i][1]);
+        }
+    }
+    storeTile(tile, c, ldc, mr, nr, accumulate);
+}
+
+// AVX-512DQ, int64: 8 por registro, 6 x 2 acumuladores zmm
+__attribute__((target("avx512f,avx512dq")))
+inline void microKernelInt64Avx512(int kb, const std::int64_t* a, const std::int64_t* b, std::int64_t* c, int ldc,
+                                   int mr, int nr, bool accumulate) {
+    __m512i acc[GEMM_MR][2];
+#pragma GCC unroll 8
+    for (int i = 0; i < GEMM_MR; i++) acc[i][0] = acc[i][1] = _mm512_setzero_si512();
+    for (int k = 0; k < kb; k++) {
+        __m512i b0 = _mm512_loadu_si512(b);
+        __m512i b1 = _mm512_loadu_si512(b + 8);
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++) {
+            __m512i ai = _mm512_set1_epi64(a[i]);
+            acc[i][0] = _mm512_add_epi64(acc[i][0], _mm512_mullo_epi64(ai, b0));
+            acc[i][1] = _mm512_add_epi64(acc[i][1], _mm512_mullo_epi64(ai, b1));
+        }
+        a += GEMM_MR;
+        b += GEMM_NR;
+    }
+    alignas(64) std::int64_t tile[GEMM_MR * GEMM_NR];
+#pragma GCC unroll 8
+    for (int i = 0; i < GEMM_MR; i++) {
+        _mm512_store_si512(tile + i * GEMM_NR, acc[i][0]);
+        _mm512_store_si512(tile + i * GEMM_NR + 8, acc[i][1]);
+    }
+    storeTile(tile, c, ldc, mr, nr, accumulate);
+}
+
+#endif // SIMD_X86
+
+// --- Despacho en tiempo de ejecución ---
+
+template <typename T>
+using MicroKernel = void (*)(int, const T*, const T*, T*, int, int, int, bool);
+using MicroKernelInt32 = MicroKernel<int>;
+using RowOpInt32 = void (*)(int, const int*, const int*, int*);
+
+// float, double e int64 no tienen kernel SSE4.1: en ese nivel usan el escalar
+struct SimdKernels {
+    SimdIsa isa;
+    MicroKernelInt32 microKernelInt32;
+    RowOpInt32 addInt32;
+    RowOpInt32 subInt32;
+    MicroKernel<float> microKernelFloat;
+    MicroKernel<double> microKernelDouble;
+    MicroKernel<std::int64_t> microKernelInt64;
+};
+
+// Mejor ISA soportado por la CPU (CPUID)
+inline SimdIsa detectSimdIsa() {
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdIsa::AVX512;
+    if (__builtin_cpu_supports("avx2")) return SimdIsa::AVX2;
+    if (__builtin_cpu_supports("sse4.1")) return SimdIsa::SSE41;
+#endif
+    return SimdIsa::Scalar;
+}
+
+inline SimdKernels kernelsFor(SimdIsa isa) {
+    SimdKernels k = {SimdIsa::Scalar, microKernelScalar<int>, addRowScalar<int>, subRowScalar<int>,
+                     microKernelScalar<float>, microKernelScalar<double>, microKernelScalar<std::int64_t>};
+    switch (isa) {
+#ifdef SIMD_X86
+        case SimdIsa::AVX512:
+            k = {isa, microKernelInt32Avx512, addInt32Avx512, subInt32Avx512, microKernelFloatAvx512,
+                 microKernelDoubleAvx512, microKernelInt64Avx2};
+            if (__builtin_cpu_supports("avx512dq")) k.microKernelInt64 = microKernelInt64Avx512;
+            return k;
+        case SimdIsa::AVX2:
+            k = {isa, microKernelInt32Avx2, addInt32Avx2, subInt32Avx2, k.microKernelFloat, k.microKernelDouble,
+                 microKernelInt64Avx2};
+            if (__builtin_cpu_supports("fma")) {
+                k.microKernelFloat = microKernelFloatAvx2;
+                k.microKernelDouble = microKernelDoubleAvx2;
+            }
+            return k;
+        case SimdIsa::SSE41:
+            k.isa = isa;
+            k.microKernelInt32 = microKernelInt32Sse41;
+            k.addInt32 = addInt32Sse41;
+            k.subInt32 = subInt32Sse41;
+            return k;
+#endif
+        default: return k;
+    }
+}
+
+// La variable de entorno SIMD_ISA (scalar, sse4.1, avx2, avx512) permite
+// limitar el ISA, p. ej. para probar el respaldo escalar en una máquina AVX-512.
+inline SimdIsa selectSimdIsa() {
+    SimdIsa isa = detectSimdIsa();
+    if (const char* v = std::getenv("SIMD_ISA")) {
+        SimdIsa wanted = isa;
+        if (std::strcmp(v, "scalar") == 0) wanted = SimdIsa::Scalar;
+        else if (std::strcmp(v, "sse4.1") == 0) wanted = SimdIsa::SSE41;
+        else if (std::strcmp(v, "avx2") == 0) wanted = SimdIsa::AVX2;
+        else if (std::strcmp(v, "avx512") == 0) wanted = SimdIsa::AVX512;
+        if (wanted < isa) isa = wanted;
+    }
+    return isa;
+}
+
+inline const SimdKernels& simdKernels() {
+    static const SimdKernels kernels = kernelsFor(selectSimdIsa());
+    return kernels;
+}
+
+#endif
@@ -0,0 +1,192 @@
+#ifndef SMALL_GEMM_HPP
+#define SMALL_GEMM_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+#include "Matrix.hpp"
+#include "Simd.hpp"
+
+// Producto para matrices pequeñas (hasta ~64 x 64) sin empaquetar paneles:
+// con tan pocos datos, copiar A y B a los buffers de GEMM cuesta tanto como
+// multiplicar. C se recorre en tiles de SMALL_GEMM_ROWS filas por una línea de
+// caché de columnas, cuyo acumulador (tamaño fijo) vive en registros; A y B se
+// leen directamente con su stride. El mismo cuerpo se compila para cada ISA con
+// su atributo target y se elige al arrancar, como los microkernels de Simd.hpp;
+// las filas por tile son 4 con 16 registros (escalar, AVX2) y 8 con los 32 de AVX-512.
+
+constexpr int SMALL_GEMM_MAX = 64; // Dimensión máxima para la que compensa este kernel
+
+#define SMALL_GEMM_INLINE inline __attribute__((always_inline))
+
+// Un paso k del tile: acc[r][:] += A[i0 + r][k] * B[k][j0:j0 + W]
+template <typename T, typename Acc, int R, int W>
+SMALL_GEMM_INLINE void smallGemmStep(Acc (&acc)[R][W], MatrixView<const T> A, MatrixView<const T> B, int i0,
+                                     int j0, int k) {
+    const T* b = B[k] + j0;
+#pragma GCC unroll 16
+    for (int r = 0; r < R; r++) {
+        Acc a = Acc(A[i0 + r][k]);
+        for (int j = 0; j < W; j++) acc[r][j] += a * Acc(b[j]);
+    }
+}
+
+// Tile R x W de C con acumulador en registros: W columnas desde j0, R filas
+// desde i0. Con KF > 0 la dimensión común es fija (kernels de tamaño fijo)
+template <typename T, typename Acc, int R, int W, int KF = 0>
+SMALL_GEMM_INLINE void smallGemmTile(MatrixView<const T> A, MatrixView<const T> B, MatrixView<Acc> C, int i0,
+                                     int j0, bool accumulate) {
+    Acc acc[R][W] = {};
+    if constexpr (KF > 0) {
+#pragma GCC unroll 8
+        for (int k = 0; k < KF; k++) smallGemmStep<T, Acc, R, W>(acc, A, B, i0, j0, k);
+    } else {
+        int K = A.cols();
+        for (int k = 0; k < K; k++) smallGemmStep<T, Acc, R, W>(acc, A, B, i0, j0, k);
+    }
+#pragma GCC unroll 16
+    for (int r = 0; r < R; r++) {
+        Acc* c = C[i0 + r] + j0;
+        if (accumulate) {
+            for (int j = 0; j < W; j++) c[j] += acc[r][j];
+        } else {
+            for (int j = 0; j < W; j++) c[j] = acc[r][j];
+        }
+    }
+}
+
+// Columnas sobrantes (menos de una línea de caché): bucle i-k-j directo
+template <typename T, typename Acc>
+SMALL_GEMM_INLINE void smallGemmEdge(MatrixView<const T> A, MatrixView<const T> B, MatrixView<Acc> C, int j0,
+                                     bool accumulate) {
+    int M = A.rows(), K = A.cols(), N = B.cols();
+    for (int i = 0; i < M; i++) {
+        Acc* c = C[i];
+        if (!accumulate) std::fill(c + j0, c + N, Acc(0));
+        for (int k = 0; k < K; k++) {
+            Acc a = Acc(A[i][k]);
+            const T* b = B[k];
+            for (int j = j0; j < N; j++) c[j] += a * Acc(b[j]);
+        }
+    }
+}
+
+// Franjas de W columnas desde j mientras quepan; devuelve la primera columna sin cubrir
+template <typename T, typename Acc, int R, int W>
+SMALL_GEMM_INLINE int smallGemmStrips(MatrixView<const T> A, MatrixView<const T> B, MatrixView<Acc> C, int j,
+                                      bool accumulate) {
+    int M = A.rows(), N = B.cols();
+    for (; j + W <= N; j += W) {
+        int i = 0;
+        for (; i + R <= M; i += R) smallGemmTile<T, Acc, R, W>(A, B, C, i, j, accumulate);
+        for (; i < M; i++) smallGemmTile<T, Acc, 1, W>(A, B, C, i, j, accumulate);
+    }
+    return j;
+}
+
+// --- Kernels de tamaño fijo: N x N con N conocido al compilar ---
+
+// Tamaños con kernel propio; isFixedGemmSize dice si un producto M x K x N usa uno
+constexpr int FIXED_GEMM_SIZES[] = {4, 8, 16, 32};
+
+inline bool isFixedGemmSize(int M, int K, int N) {
+    if (M != K || K != N) return false;
+    for (int n : FIXED_GEMM_SIZES) {
+        if (n == N) return true;
+    }
+    return false;
+}
+
+// Todos los bucles tienen límites constantes: tiles de R filas (o N si es
+// menor) por una línea de caché de columnas (o N), desenrollados por completo
+// con el acumulador en registros, y el bucle k desenrollado de 8 en 8
+template <typename T, typename Acc, int N, int R>
+SMALL_GEMM_INLINE void fixedGemm(MatrixView<const T> A, MatrixView<const T> B, MatrixView<Acc> C, bool accumulate) {
+    constexpr int W = std::min(N, (int)(MATRIX_ALIGNMENT / sizeof(Acc)));
+    constexpr int RT = std::min(N, R);
+    static_assert(N % W == 0 && N % RT == 0, "N debe ser múltiplo del tile");
+    for (int j = 0; j < N; j += W) {
+        for (int i = 0; i < N; i += RT) smallGemmTile<T, Acc, RT, W, N>(A, B, C, i, j, accumulate);
+    }
+}
+
+// Despacho del tamaño en ejecución a la instancia fija (false si no hay una)
+template <typename T, typename Acc, int R>
+SMALL_GEMM_INLINE bool fixedGemmDispatch(MatrixView<const T> A, MatrixView<const T> B, MatrixView<Acc> C,
+                                         bool accumulate) {
+    if (!isFixedGemmSize(A.rows(), A.cols(), B.cols())) return false;
+    switch (A.rows()) {
+        case 4: fixedGemm<T, Acc, 4, R>(A, B, C, accumulate); return true;
+        case 8: fixedGemm<T, Acc, 8, R>(A, B, C, accumulate); return true;
+        case 16: fixedGemm<T, Acc, 16, R>(A, B, C, accumulate); return true;
+        case 32: fixedGemm<T, Acc, 32, R>(A, B, C, accumulate); return true;
+        default: return false;
+    }
+}
+
+// R filas por tile. Los tamaños de FIXED_GEMM_SIZES van a su kernel fijo; el
+// resto, franjas de una línea de caché de C, luego de media y de un cuarto
+// (matrices de 8 o 4 columnas), y lo que quede con el bucle directo
+template <typename T, typename Acc, int R>
+SMALL_GEMM_INLINE void smallGemmBody(MatrixView<const T> A, MatrixView<const T> B, MatrixView<Acc> C,
+                                     bool accumulate) {
+    if (fixedGemmDispatch<T, Acc, R>(A, B, C, accumulate)) return;
+    constexpr int W = (int)(MATRIX_ALIGNMENT / sizeof(Acc));
+    int j = smallGemmStrips<T, Acc, R, W>(A, B, C, 0, accumulate);
+    j = smallGemmStrips<T, Acc, R, W / 2>(A, B, C, j, accumulate);
+    j = smallGemmStrips<T, Acc, R, W / 4>(A, B, C, j, accumulate);
+    if (j < B.cols()) smallGemmEdge<T, Acc>(A, B, C, j, accumulate);
+}
+
+template <typename T, typename Acc>
+using SmallGemmKernel = void (*)(MatrixView<const T>, MatrixView<const T>, MatrixView<Acc>, bool);
+
+template <typename T, typename Acc>
+void smallGemmScalar(MatrixView<const T> A, MatrixView<const T> B, MatrixView<Acc> C, bool accumulate) {
+    smallGemmBody<T, Acc, 4>(A, B, C, accumulate);
+}
+
+#ifdef SIMD_X86
+
+template <typename T, typename Acc>
+__attribute__((target("avx2,fma")))
+void smallGemmAvx2(MatrixView<const T> A, MatrixView<const T> B, MatrixView<Acc> C, bool accumulate) {
+    smallGemmBody<T, Acc, 4>(A, B, C, accumulate);
+}
+
+template <typename T, typename Acc>
+__attribute__((target("avx512f,avx512dq")))
+void smallGemmAvx512(MatrixView<const T> A, MatrixView<const T> B, MatrixView<Acc> C, bool accumulate) {
+    smallGemmBody<T, Acc, 8>(A, B, C, accumulate);
+}
+
+#endif
+
+// Versión del kernel pequeño para el ISA elegido en Simd.hpp (SIMD_ISA incluido)
+template <typename T, typename Acc>
+SmallGemmKernel<T, Acc> selectSmallGemm(SimdIsa isa) {
+#ifdef SIMD_X86
+    // Con elementos int64 el compilador no vectoriza bien este cuerpo para
+    // AVX-512 (multiplicación de 64 bits): la versión AVX2 es más rápida
+    bool wideInt = std::is_integral_v<T> && sizeof(T) == 8;
+    if (isa == SimdIsa::AVX512 && !wideInt && __builtin_cpu_supports("avx512dq")) return smallGemmAvx512<T, Acc>;
+    if (isa >= SimdIsa::AVX2 && __builtin_cpu_supports("fma")) return smallGemmAvx2<T, Acc>;
+#endif
+    (void)isa;
+    return smallGemmScalar<T, Acc>;
+}
+
+template <typename T, typename Acc = T>
+SmallGemmKernel<T, Acc> smallGemmKernel() {
+    static const SmallGemmKernel<T, Acc> kernel = selectSmallGemm<T, Acc>(simdKernels().isa);
+    return kernel;
+}
+
+// C (+)= A * B para matrices pequeñas (ver SMALL_GEMM_MAX)
+template <typename T, typename Acc = T>
+void smallGemm(MatrixView<const T> A, MatrixView<const T> B, MatrixView<Acc> C, bool accumulate = false) {
+    smallGemmKernel<T, Acc>()(A, B, C, accumulate);
+}
+
+#endif
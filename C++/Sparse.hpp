@@ -0,0 +1,511 @@
+#ifndef SPARSE_HPP
+#define SPARSE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Chain.hpp"
+#include "Matrix.hpp"
+#include "MatrixExpr.hpp"
+#include "RandomMatrix.hpp"
+#include "Simd.hpp"
+#include "Strassen.hpp"
+#include "ThreadPool.hpp"
+
+// Matrices dispersas y productos que solo recorren los elementos distintos de
+// 0. SparseMatrix guarda los no nulos comprimidos por filas (CSR) o por
+// columnas (CSC); el CSR de A es el CSC de A^T, así que transponer es
+// reinterpretar los mismos arrays. Los kernels trabajan sobre CSR y
+// convierten una entrada CSC en O(nnz): dispersa x densa (axpy vectorizado
+// por fila), densa x dispersa (el mismo kernel sobre las traspuestas) y
+// dispersa x dispersa (Gustavson, con salida densa o CSR).
+//
+// multiply_sparse_aware estima la densidad de A y B con una muestra de
+// posiciones aleatorias y elige, con un modelo de coste, entre el motor denso
+// (bloques o Strassen, con el coste de Chain.hpp) y los kernels dispersos.
+//
+// Los kernels no multiplican los ceros que no se guardan: si el otro operando
+// tiene Inf o NaN, 0 * Inf no aporta el NaN que daría el producto denso.
+// multiply_sparse_aware solo toma una ruta dispersa si el operando que se
+// cruza con los ceros omitidos es finito.
+
+#define SPARSE_INLINE inline __attribute__((always_inline))
+
+enum class SparseLayout { Csr, Csc };
+
+template <typename T>
+class SparseMatrix {
+public:
+    SparseMatrix() = default;
+
+    // Matriz vacía (sin no nulos) de rows x cols
+    SparseMatrix(int rows, int cols, SparseLayout layout = SparseLayout::Csr)
+        : rows_(rows), cols_(cols), layout_(layout), ptr_((size_t)major() + 1, 0) {}
+
+    // Desde los arrays comprimidos: ptr tiene major() + 1 entradas e idx/values
+    // ptr.back(); idx son columnas (CSR) o filas (CSC). Lanza invalid_argument
+    // si no son coherentes.
+    SparseMatrix(int rows, int cols, SparseLayout layout, std::vector<std::int64_t> ptr, std::vector<int> idx,
+                 std::vector<T> values)
+        : rows_(rows), cols_(cols), layout_(layout), ptr_(std::move(ptr)), idx_(std::move(idx)),
+          values_(std::move(values)) {
+        int minor = layout_ == SparseLayout::Csr ? cols_ : rows_;
+        bool ok = ptr_.size() == (size_t)major() + 1 && ptr_.front() == 0 && idx_.size() == values_.size() &&
+                  (size_t)ptr_.back() == idx_.size();
+        for (int m = 0; ok && m < major(); m++) ok = ptr_[m] <= ptr_[m + 1];
+        for (int i : idx_) ok = ok && i >= 0 && i < minor;
+        if (!ok) throw std::invalid_argument("Arrays CSR/CSC incoherentes");
+    }
+
+    // Comprime una matriz densa (sin los ceros); las filas se reparten entre
+    // los hilos del pool. Una pasada cuenta los no nulos de cada fila (en
+    // tramos de ancho fijo, que se vectorizan) y otra los copia sin saltos:
+    // cada elemento se escribe en un búfer de fila y el cursor solo avanza si
+    // no es 0, así que la densidad no provoca fallos de predicción
+    static SparseMatrix fromDense(MatrixView<const T> A, SparseLayout layout = SparseLayout::Csr) {
+        constexpr int W = MATRIX_EXPR_BLOCK;
+        int cols = A.cols();
+        SparseMatrix csr(A.rows(), cols, SparseLayout::Csr);
+        std::vector<std::int64_t>& ptr = csr.ptr_;
+        parallelRows(defaultThreadPool(), A.rows(), cols, [&](int first, int last) {
+            for (int i = first; i < last; i++) {
+                const T* row = A[i];
+                int count = 0, j = 0;
+                for (; j + W <= cols; j += W) {
+                    for (int k = 0; k < W; k++) count += row[j + k] != T(0);
+                }
+                for (; j < cols; j++) count += row[j] != T(0);
+                ptr[i + 1] = count;
+            }
+        });
+        for (int i = 0; i < A.rows(); i++) ptr[i + 1] += ptr[i];
+        csr.idx_.resize((size_t)ptr.back());
+        csr.values_.resize((size_t)ptr.back());
+        parallelRows(defaultThreadPool(), A.rows(), cols, [&](int first, int last) {
+            std::vector<int> rowIdx(cols);
+            std::vector<T> rowValues(cols);
+            for (int i = first; i < last; i++) {
+                const T* row = A[i];
+                int count = 0;
+                for (int j = 0; j < cols; j++) {
+                    rowIdx[count] = j;
+                    rowValues[count] = row[j];
+                    count += row[j] != T(0);
+                }
+                std::copy(rowIdx.begin(), rowIdx.begin() + count, csr.idx_.begin() + ptr[i]);
+                std::copy(rowValues.begin(), rowValues.begin() + count, csr.values_.begin() + ptr[i]);
+            }
+        });
+        if (layout == SparseLayout::Csr) return csr;
+        return csr.toLayout(SparseLayout::Csc);
+    }
+
+    Matrix<T> toDense() const {
+        Matrix<T> A(rows_, cols_);
+        for (int m = 0; m < major(); m++) {
+            for (std::int64_t p = ptr_[m]; p < ptr_[m + 1]; p++) {
+                if (layout_ == SparseLayout::Csr) A[m][idx_[p]] = values_[p];
+                else A[idx_[p]][m] = values_[p];
+            }
+        }
+        return A;
+    }
+
+    // La misma matriz en otra compresión (recuento por índice: O(nnz + filas + columnas))
+    SparseMatrix toLayout(SparseLayout layout) const {
+        if (layout == layout_) return *this;
+        SparseMatrix out(rows_, cols_, layout);
+        int minor = out.major();
+        std::vector<std::int64_t>& ptr = out.ptr_;
+        for (int i : idx_) ptr[i + 1]++;
+        for (int m = 0; m < minor; m++) ptr[m + 1] += ptr[m];
+        out.idx_.resize(idx_.size());
+        out.values_.resize(values_.size());
+        std::vector<std::int64_t> next(ptr.begin(), ptr.end() - 1);
+        for (int m = 0; m < major(); m++) {
+            for (std::int64_t p = ptr_[m]; p < ptr_[m + 1]; p++) {
+                std::int64_t q = next[idx_[p]]++;
+                out.idx_[q] = m;
+                out.values_[q] = values_[p];
+            }
+        }
+        return out;
+    }
+
+    // A^T sin reordenar los arrays: el CSR de A se lee como el CSC de A^T
+    SparseMatrix transposed() const {
+        SparseMatrix t = *this;
+        std::swap(t.rows_, t.cols_);
+        t.layout_ = layout_ == SparseLayout::Csr ? SparseLayout::Csc : SparseLayout::Csr;
+        return t;
+    }
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    SparseLayout layout() const { return layout_; }
+    std::int64_t nnz() const { return ptr_.empty() ? 0 : ptr_.back(); }
+    double density() const { return rows_ && cols_ ? (double)nnz() / ((double)rows_ * cols_) : 0.0; }
+
+    // Filas (CSR) o columnas (CSC) comprimidas
+    int major() const { return layout_ == SparseLayout::Csr ? rows_ : cols_; }
+    const std::vector<std::int64_t>& ptr() const { return ptr_; }
+    const std::vector<int>& idx() const { return idx_; }
+    const std::vector<T>& values() const { return values_; }
+
+private:
+    int rows_ = 0;
+    int cols_ = 0;
+    SparseLayout layout_ = SparseLayout::Csr;
+    std::vector<std::int64_t> ptr_;
+    std::vector<int> idx_;
+    std::vector<T> values_;
+};
+
+// --- Kernels ---
+
+// El CSR de A: la propia A o su conversión (en conv) si está en CSC
+template <typename T>
+const SparseMatrix<T>& sparseAsCsr(const SparseMatrix<T>& A, SparseMatrix<T>& conv) {
+    if (A.layout() == SparseLayout::Csr) return A;
+    conv = A.toLayout(SparseLayout::Csr);
+    return conv;
+}
+
+// fn(first, last) sobre tramos de filas de A (CSR) con un número parecido de
+// no nulos, uno por hilo del pool (si hay trabajo para varios)
+template <typename T, typename F>
+void sparseParallelByNnz(const SparseMatrix<T>& A, long long workPerNnz, F fn) {
+    ThreadPool& pool = defaultThreadPool();
+    const std::vector<std::int64_t>& ptr = A.ptr();
+    long long work = (long long)A.nnz() * std::max(workPerNnz, 1LL) + A.rows();
+    int tasks = (int)std::min<long long>(pool.size(), std::max<long long>(1, work / 65536));
+    tasks = std::min(tasks, std::max(A.rows(), 1));
+    if (tasks <= 1) {
+        fn(0, A.rows());
+        return;
+    }
+    // Cortes donde el recuento acumulado de no nulos pasa por nnz * t / tasks
+    std::vector<int> cut(tasks + 1, A.rows());
+    cut[0] = 0;
+    for (int t = 1; t < tasks; t++) {
+        std::int64_t target = A.nnz() * t / tasks;
+        cut[t] = (int)(std::upper_bound(ptr.begin(), ptr.end(), target) - ptr.begin()) - 1;
+        cut[t] = std::max(cut[t], cut[t - 1]);
+    }
+    TaskGroup group(pool);
+    for (int t = 0; t < tasks; t++) {
+        if (cut[t] < cut[t + 1]) group.run([&, t] { fn(cut[t], cut[t + 1]); });
+    }
+    group.wait();
+}
+
+// Filas [first, last) de C = A (CSR: ptr, idx, values) * B densa: cada no
+// nulo a(i, k) suma a * B[k] a la fila i de C, un axpy en tramos de ancho
+// fijo para que se vectorice (ivdep: C no se solapa con B)
+template <typename T, typename Acc>
+SPARSE_INLINE void sparseDenseRowsBody(const std::int64_t* ptr, const int* idx, const T* values,
+                                       MatrixView<const T> B, MatrixView<Acc> C, int first, int last) {
+    constexpr int W = MATRIX_EXPR_BLOCK;
+    int N = C.cols();
+    for (int i = first; i < last; i++) {
+        Acc* c = C[i];
+        std::fill(c, c + N, Acc(0));
+        for (std::int64_t p = ptr[i]; p < ptr[i + 1]; p++) {
+            Acc a = Acc(values[p]);
+            const T* b = B[idx[p]];
+            int j = 0;
+            for (; j + W <= N; j += W) {
+#pragma GCC ivdep
+                for (int k = 0; k < W; k++) c[j + k] += a * Acc(b[j + k]);
+            }
+            for (; j < N; j++) c[j] += a * Acc(b[j]);
+        }
+    }
+}
+
+template <typename T, typename Acc>
+void sparseDenseRowsScalar(const std::int64_t* ptr, const int* idx, const T* values, MatrixView<const T> B,
+                           MatrixView<Acc> C, int first, int last) {
+    sparseDenseRowsBody<T, Acc>(ptr, idx, values, B, C, first, last);
+}
+
+#ifdef SIMD_X86
+
+template <typename T, typename Acc>
+__attribute__((target("avx2"))) void sparseDenseRowsAvx2(const std::int64_t* ptr, const int* idx, const T* values,
+                                                         MatrixView<const T> B, MatrixView<Acc> C, int first,
+                                                         int last) {
+    sparseDenseRowsBody<T, Acc>(ptr, idx, values, B, C, first, last);
+}
+
+template <typename T, typename Acc>
+__attribute__((target("avx512f"))) void sparseDenseRowsAvx512(const std::int64_t* ptr, const int* idx,
+                                                             const T* values, MatrixView<const T> B,
+                                                             MatrixView<Acc> C, int first, int last) {
+    sparseDenseRowsBody<T, Acc>(ptr, idx, values, B, C, first, last);
+}
+
+#endif
+
+// C (M x N) = A (M x K, dispersa) * B (K x N, densa), con el bucle del ISA
+// elegido al arrancar. Las filas de C se reparten entre hilos por número de
+// no nulos.
+template <typename T, typename Acc = T>
+void sparse_dense_multiply(const SparseMatrix<T>& A, MatrixView<const T> B, MatrixView<Acc> C) {
+    SparseMatrix<T> conv;
+    const SparseMatrix<T>& csr = sparseAsCsr(A, conv);
+    const std::int64_t* ptr = csr.ptr().data();
+    const int* idx = csr.idx().data();
+    const T* values = csr.values().data();
+    sparseParallelByNnz(csr, C.cols(), [&](int first, int last) {
+#ifdef SIMD_X86
+        SimdIsa isa = simdKernels().isa;
+        if (isa == SimdIsa::AVX512) return sparseDenseRowsAvx512<T, Acc>(ptr, idx, values, B, C, first, last);
+        if (isa >= SimdIsa::AVX2) return sparseDenseRowsAvx2<T, Acc>(ptr, idx, values, B, C, first, last);
+#endif
+        sparseDenseRowsScalar<T, Acc>(ptr, idx, values, B, C, first, last);
+    });
+}
+
+// c += a * B[k], con B en CSR (ptr, idx, values): reparte los no nulos de la
+// fila k sobre c
+template <typename T, typename Acc>
+inline void sparseScatterAdd(Acc* c, T a, int k, const std::int64_t* ptr, const int* idx, const T* values) {
+    Acc ak = Acc(a);
+    for (std::int64_t q = ptr[k]; q < ptr[k + 1]; q++) c[idx[q]] += ak * Acc(values[q]);
+}
+
+// At = A^T en bloques de 32 x 32, para que lecturas y escrituras se queden en caché
+template <typename T>
+void transposeMatrix(MatrixView<const T> A, MatrixView<T> At) {
+    constexpr int TILE = 32;
+    for (int ii = 0; ii < A.rows(); ii += TILE) {
+        for (int jj = 0; jj < A.cols(); jj += TILE) {
+            int iEnd = std::min(ii + TILE, A.rows()), jEnd = std::min(jj + TILE, A.cols());
+            for (int j = jj; j < jEnd; j++) {
+                T* out = At[j];
+                for (int i = ii; i < iEnd; i++) out[i] = A[i][j];
+            }
+        }
+    }
+}
+
+// C (M x N) = A (M x K, densa) * B (K x N, dispersa). Repartir a(i, k) * B[k]
+// sobre la fila de C escribe en columnas sueltas y no se vectoriza, así que
+// se calcula C^T = B^T * A^T con sparse_dense_multiply: el CSC de B es el CSR
+// de B^T, y solo hay que transponer A y C (O(n^2) frente al producto)
+template <typename T, typename Acc = T>
+void dense_sparse_multiply(MatrixView<const T> A, const SparseMatrix<T>& B, MatrixView<Acc> C) {
+    Matrix<T> At(A.cols(), A.rows());
+    Matrix<Acc> Ct(C.cols(), C.rows());
+    transposeMatrix<T>(A, At);
+    sparse_dense_multiply<T, Acc>(B.toLayout(SparseLayout::Csc).transposed(), At, Ct);
+    transposeMatrix<Acc>(Ct, C);
+}
+
+// C (densa) = A * B con las dos dispersas
+template <typename T, typename Acc = T>
+void sparse_sparse_multiply(const SparseMatrix<T>& A, const SparseMatrix<T>& B, MatrixView<Acc> C) {
+    SparseMatrix<T> convA, convB;
+    const SparseMatrix<T>& a = sparseAsCsr(A, convA);
+    const SparseMatrix<T>& b = sparseAsCsr(B, convB);
+    const std::int64_t* ptrA = a.ptr().data();
+    const int* idxA = a.idx().data();
+    const T* valuesA = a.values().data();
+    const std::int64_t* ptrB = b.ptr().data();
+    const int* idxB = b.idx().data();
+    const T* valuesB = b.values().data();
+    int N = C.cols();
+    long long perNnz = 2 * (b.nnz() / std::max(b.rows(), 1)) + 1;
+    sparseParallelByNnz(a, perNnz, [&](int first, int last) {
+        for (int i = first; i < last; i++) {
+            Acc* c = C[i];
+            std::fill(c, c + N, Acc(0));
+            for (std::int64_t p = ptrA[i]; p < ptrA[i + 1]; p++) {
+                sparseScatterAdd<T, Acc>(c, valuesA[p], idxA[p], ptrB, idxB, valuesB);
+            }
+        }
+    });
+}
+
+// C = A * B dispersa (CSR) con el algoritmo de Gustavson: cada fila se
+// acumula en un vector denso de N elementos del hilo, junto con la lista de
+// columnas tocadas, y solo esas se vuelcan (ordenadas) al resultado. Las
+// cancelaciones exactas (suma 0) no se guardan.
+template <typename T, typename Acc = T>
+SparseMatrix<Acc> sparse_sparse_multiply(const SparseMatrix<T>& A, const SparseMatrix<T>& B) {
+    SparseMatrix<T> convA, convB;
+    const SparseMatrix<T>& a = sparseAsCsr(A, convA);
+    const SparseMatrix<T>& b = sparseAsCsr(B, convB);
+    int M = a.rows(), N = b.cols();
+    if (a.cols() != b.rows()) throw std::invalid_argument("Dimensiones incompatibles en sparse_sparse_multiply");
+
+    const std::int64_t* ptrA = a.ptr().data();
+    const int* idxA = a.idx().data();
+    const T* valuesA = a.values().data();
+    const std::int64_t* ptrB = b.ptr().data();
+    const int* idxB = b.idx().data();
+    const T* valuesB = b.values().data();
+
+    // Cada tramo de filas deja sus filas en vectores propios; luego se concatenan
+    std::vector<std::int64_t> rowNnz((size_t)M + 1, 0);
+    std::vector<int> partFirst;
+    std::vector<std::vector<int>> partIdx;
+    std::vector<std::vector<Acc>> partValues;
+    std::mutex partsMutex;
+    long long perNnz = 2 * (b.nnz() / std::max(b.rows(), 1)) + 1;
+    sparseParallelByNnz(a, perNnz, [&](int first, int last) {
+        std::vector<Acc> acc(N, Acc(0));
+        std::vector<char> used(N, 0);
+        std::vector<int> touched, idx;
+        std::vector<Acc> values;
+        for (int i = first; i < last; i++) {
+            touched.clear();
+            for (std::int64_t p = ptrA[i]; p < ptrA[i + 1]; p++) {
+                int k = idxA[p];
+                Acc ak = Acc(valuesA[p]);
+                for (std::int64_t q = ptrB[k]; q < ptrB[k + 1]; q++) {
+                    int j = idxB[q];
+                    if (!used[j]) {
+                        used[j] = 1;
+                        touched.push_back(j);
+                    }
+                    acc[j] += ak * Acc(valuesB[q]);
+                }
+            }
+            std::sort(touched.begin(), touched.end());
+            std::int64_t count = 0;
+            for (int j : touched) {
+                if (acc[j] != Acc(0)) {
+                    idx.push_back(j);
+                    values.push_back(acc[j]);
+                    count++;
+                }
+                acc[j] = Acc(0);
+                used[j] = 0;
+            }
+            rowNnz[i + 1] = count;
+        }
+        std::lock_guard<std::mutex> lock(partsMutex);
+        partFirst.push_back(first);
+        partIdx.push_back(std::move(idx));
+        partValues.push_back(std::move(values));
+    });
+
+    for (int i = 0; i < M; i++) rowNnz[i + 1] += rowNnz[i];
+    std::vector<int> idx((size_t)rowNnz[M]);
+    std::vector<Acc> values((size_t)rowNnz[M]);
+    for (size_t part = 0; part < partFirst.size(); part++) {
+        std::int64_t at = rowNnz[partFirst[part]];
+        std::copy(partIdx[part].begin(), partIdx[part].end(), idx.begin() + at);
+        std::copy(partValues[part].begin(), partValues[part].end(), values.begin() + at);
+    }
+    return SparseMatrix<Acc>(M, N, SparseLayout::Csr, std::move(rowNnz), std::move(idx), std::move(values));
+}
+
+// --- Despacho por densidad ---
+
+constexpr int SPARSE_DENSITY_SAMPLES = 4096; // Posiciones muestreadas por matriz
+
+// Coste de cada paso de los kernels dispersos en las unidades de
+// chainProductCost (una operación del motor denso), medido con float e int32
+// en AVX-512 para n = 256..2048; con tipos de 8 bytes el motor denso es más
+// lento y el reparto resulta algo conservador
+constexpr double SPARSE_SCAN_COST = 30.0;       // fromDense: por elemento leído y otro tanto por no nulo
+constexpr double SPARSE_AXPY_COST = 1.5;        // Una operación de sparse_dense_multiply (vectorizada)
+constexpr double SPARSE_SCATTER_COST = 12.0;    // Una operación de sparse_sparse_multiply (columnas sueltas)
+constexpr double SPARSE_TRANSPOSE_COST = 60.0;  // Transponer un elemento (dense_sparse_multiply)
+
+// Fracción estimada de elementos distintos de 0: exacta si la matriz tiene
+// como mucho samples elementos; si no, de samples posiciones aleatorias
+// (RandomMatrix.hpp), con un error típico de ~sqrt(d / samples)
+template <typename T>
+double estimateDensity(MatrixView<const T> A, int samples = SPARSE_DENSITY_SAMPLES, uint64_t seed = 1) {
+    long long total = (long long)A.rows() * A.cols();
+    if (total == 0) return 0.0;
+    long long nonzero = 0;
+    if (total <= samples) {
+        for (int i = 0; i < A.rows(); i++) {
+            for (int j = 0; j < A.cols(); j++) nonzero += A[i][j] != T(0);
+        }
+        return (double)nonzero / (double)total;
+    }
+    std::vector<uint32_t> words(2 * (size_t)samples);
+    randomWords(words.data(), (int)words.size(), seed, 0);
+    for (int s = 0; s < samples; s++) {
+        int i = (int)(((uint64_t)words[2 * s] * (uint64_t)A.rows()) >> 32);
+        int j = (int)(((uint64_t)words[2 * s + 1] * (uint64_t)A.cols()) >> 32);
+        nonzero += A[i][j] != T(0);
+    }
+    return (double)nonzero / samples;
+}
+
+enum class MultiplyRoute { Dense, SparseDense, DenseSparse, SparseSparse };
+
+inline const char* multiplyRouteName(MultiplyRoute route) {
+    switch (route) {
+        case MultiplyRoute::SparseDense: return "dispersa x densa";
+        case MultiplyRoute::DenseSparse: return "densa x dispersa";
+        case MultiplyRoute::SparseSparse: return "dispersa x dispersa";
+        default: return "densa";
+    }
+}
+
+struct SparseDispatch {
+    MultiplyRoute route = MultiplyRoute::Dense;
+    double densityA = 1.0, densityB = 1.0; // Estimadas
+    double denseCost = 0.0, sparseCost = 0.0; // Del motor denso y de la ruta dispersa más barata
+};
+
+// Ruta más barata para A (M x K) * B (K x N) con esas densidades
+inline SparseDispatch chooseMultiplyRoute(int M, int K, int N, double densityA, double densityB) {
+    SparseDispatch d;
+    d.densityA = densityA;
+    d.densityB = densityB;
+    d.denseCost = chainProductCost(M, K, N);
+    double mk = (double)M * K, kn = (double)K * N, mn = (double)M * N;
+    double nnzA = densityA * mk, nnzB = densityB * kn;
+    double compressA = SPARSE_SCAN_COST * (mk + nnzA), compressB = SPARSE_SCAN_COST * (kn + nnzB);
+    std::pair<double, MultiplyRoute> routes[] = {
+        {compressA + SPARSE_AXPY_COST * 2.0 * nnzA * N + mn, MultiplyRoute::SparseDense},
+        {compressB + SPARSE_TRANSPOSE_COST * (mk + mn) + SPARSE_AXPY_COST * 2.0 * nnzB * M + mn,
+         MultiplyRoute::DenseSparse},
+        {compressA + compressB + SPARSE_SCATTER_COST * 2.0 * nnzA * (nnzB / std::max(K, 1)) + mn,
+         MultiplyRoute::SparseSparse},
+    };
+    auto best = *std::min_element(std::begin(routes), std::end(routes));
+    d.sparseCost = best.first;
+    if (best.first < d.denseCost) d.route = best.second;
+    return d;
+}
+
+// C = A * B con el motor denso o el disperso según la densidad estimada de
+// A y B; report recibe la decisión si no es nulo. Con Inf o NaN en el
+// operando que se multiplicaría por los ceros omitidos (B si se comprime A,
+// A si se comprime B) se usa el motor denso, que los propaga como IEEE
+template <typename T, typename Acc = T>
+Matrix<Acc> multiply_sparse_aware(MatrixView<const T> A, MatrixView<const T> B, SparseDispatch* report = nullptr) {
+    int M = A.rows(), K = A.cols(), N = B.cols();
+    SparseDispatch d =
+        chooseMultiplyRoute(M, K, N, estimateDensity<T>(A), estimateDensity<T>(B, SPARSE_DENSITY_SAMPLES, 2));
+    bool compressA = d.route == MultiplyRoute::SparseDense || d.route == MultiplyRoute::SparseSparse;
+    bool compressB = d.route == MultiplyRoute::DenseSparse || d.route == MultiplyRoute::SparseSparse;
+    if ((compressA && !isFiniteMatrix<T>(B)) || (compressB && !isFiniteMatrix<T>(A))) d.route = MultiplyRoute::Dense;
+    if (report != nullptr) *report = d;
+    if (d.route == MultiplyRoute::Dense) return multiply<T, Acc>(M, K, N, A, B);
+    Matrix<Acc> C(M, N);
+    if (d.route == MultiplyRoute::SparseDense) {
+        sparse_dense_multiply<T, Acc>(SparseMatrix<T>::fromDense(A), B, C);
+    } else if (d.route == MultiplyRoute::DenseSparse) {
+        dense_sparse_multiply<T, Acc>(A, SparseMatrix<T>::fromDense(B), C);
+    } else {
+        sparse_sparse_multiply<T, Acc>(SparseMatrix<T>::fromDense(A), SparseMatrix<T>::fromDense(B), C);
+    }
+    return C;
+}
+
+#endif
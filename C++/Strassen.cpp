@@ -1,237 +1,415 @@
-#include <iostream>
-#include <vector>
-#include <random>
-#include <chrono>
-
-#define STRASSEN_THRESHOLD 64 // Umbral para cambiar a algoritmo ingenuo
-
-using namespace std;
-using namespace chrono;
-
-// --- Funciones Auxiliares (Comunes) ---
-using Matrix = vector<vector<int>>;
-
-Matrix allocateMatrix(int size) {
-    if (size < 0) return {};
-    return Matrix(size, vector<int>(size, 0)); // Inicializa una matriz NxN con 0
-}
-
-void fillRandomMatrix(int size, Matrix& matrix) {
-    random_device rd;
-    mt19937 gen(rd());
-    uniform_int_distribution<> dis(0, 9); // Números aleatorios entre 0 y 9
-
-    for (int i = 0; i < size; i++) {
-        for (int j = 0; j < size; j++) {
-            matrix[i][j] = dis(gen);
-        }
-    }
-}
-
-void printMatrix(int size, const Matrix& matrix, const string& name) {
-    if (size <= 0) {
-        cout << "Matriz " << name << " no es válida o está vacía.\n";
-        return;
-    }
-    cout << "Matriz " << name << " (" << size << "x" << size << "):\n";
-    for (int i = 0; i < size; i++) {
-        for (int j = 0; j < size; j++) {
-            cout << matrix[i][j] << "\t";
-        }
-        cout << endl;
-    }
-    cout << endl;
-}
-
-// --- Funciones Específicas de Strassen ---
-
-void addMatrices(int size, const Matrix& A, const Matrix& B, Matrix& C) {
-    for (int i = 0; i < size; i++) {
-        for (int j = 0; j < size; j++) {
-            C[i][j] = A[i][j] + B[i][j];
-        }
-    }
-}
-
-void subtractMatrices(int size, const Matrix& A, const Matrix& B, Matrix& C) {
-    for (int i = 0; i < size; i++) {
-        for (int j = 0; j < size; j++) {
-            C[i][j] = A[i][j] - B[i][j];
-        }
-    }
-}
-
-Matrix naive_multiply_strassen_base(int size, const Matrix& A, const Matrix& B) {
-    Matrix C(size, vector<int>(size, 0));
-    for (int i = 0; i < size; i++) {
-        for (int j = 0; j < size; j++) {
-            for (int k = 0; k < size; k++) {
-                C[i][j] += A[i][k] * B[k][j];
-            }
-        }
-    }
-    return C;
-}
-
-Matrix strassen_multiply_internal(int size, const Matrix& A, const Matrix& B) {
-    if (size <= STRASSEN_THRESHOLD) {
-        return naive_multiply_strassen_base(size, A, B);
-    }
-
-    int newSize = size / 2;
-
-    // Submatrices
-    Matrix A11 = allocateMatrix(newSize), A12 = allocateMatrix(newSize);
-    Matrix A21 = allocateMatrix(newSize), A22 = allocateMatrix(newSize);
-    Matrix B11 = allocateMatrix(newSize), B12 = allocateMatrix(newSize);
-    Matrix B21 = allocateMatrix(newSize), B22 = allocateMatrix(newSize);
-
-    // Temporary matrices
-    Matrix tempA = allocateMatrix(newSize), tempB = allocateMatrix(newSize);
-
-    // Divide matrices A and B into submatrices
-    for (int i = 0; i < newSize; i++) {
-        for (int j = 0; j < newSize; j++) {
-            A11[i][j] = A[i][j]; A12[i][j] = A[i][j + newSize];
-            A21[i][j] = A[i + newSize][j]; A22[i][j] = A[i + newSize][j + newSize];
-            B11[i][j] = B[i][j]; B12[i][j] = B[i][j + newSize];
-            B21[i][j] = B[i + newSize][j]; B22[i][j] = B[i + newSize][j + newSize];
-        }
-    }
-
-    // P1 = (A11 + A22) * (B11 + B22)
-    addMatrices(newSize, A11, A22, tempA);
-    addMatrices(newSize, B11, B22, tempB);
-    Matrix P1 = strassen_multiply_internal(newSize, tempA, tempB);
-
-    // P2 = (A21 + A22) * B11
-    addMatrices(newSize, A21, A22, tempA);
-    Matrix P2 = strassen_multiply_internal(newSize, tempA, B11);
-
-    // P3 = A11 * (B12 - B22)
-    subtractMatrices(newSize, B12, B22, tempB);
-    Matrix P3 = strassen_multiply_internal(newSize, A11, tempB);
-
-    // P4 = A22 * (B21 - B11)
-    subtractMatrices(newSize, B21, B11, tempB);
-    Matrix P4 = strassen_multiply_internal(newSize, A22, tempB);
-
-    // P5 = (A11 + A12) * B22
-    addMatrices(newSize, A11, A12, tempA);
-    Matrix P5 = strassen_multiply_internal(newSize, tempA, B22);
-
-    // P6 = (A21 - A11) * (B11 + B12)
-    subtractMatrices(newSize, A21, A11, tempA);
-    addMatrices(newSize, B11, B12, tempB);
-    Matrix P6 = strassen_multiply_internal(newSize, tempA, tempB);
-
-    // P7 = (A12 - A22) * (B21 + B22)
-    subtractMatrices(newSize, A12, A22, tempA);
-    addMatrices(newSize, B21, B22, tempB);
-    Matrix P7 = strassen_multiply_internal(newSize, tempA, tempB);
-
-    // C11 = P1 + P4 - P5 + P7
-    Matrix C11 = allocateMatrix(newSize);
-    addMatrices(newSize, P1, P4, C11);
-    subtractMatrices(newSize, C11, P5, C11);
-    addMatrices(newSize, C11, P7, C11);
-
-    // C12 = P3 + P5
-    Matrix C12 = allocateMatrix(newSize);
-    addMatrices(newSize, P3, P5, C12);
-
-    // C21 = P2 + P4
-    Matrix C21 = allocateMatrix(newSize);
-    addMatrices(newSize, P2, P4, C21);
-
-    // C22 = P1 - P2 + P3 + P6
-    Matrix C22 = allocateMatrix(newSize);
-    subtractMatrices(newSize, P1, P2, C22);
-    addMatrices(newSize, C22, P3, C22);
-    addMatrices(newSize, C22, P6, C22);
-
-    // Final Matrix C
-    Matrix C(size, vector<int>(size, 0));
-    for (int i = 0; i < newSize; i++) {
-        for (int j = 0; j < newSize; j++) {
-            C[i][j] = C11[i][j];
-            C[i][j + newSize] = C12[i][j];
-            C[i + newSize][j] = C21[i][j];
-            C[i + newSize][j + newSize] = C22[i][j];
-        }
-    }
-
-    return C;
-}
-
-Matrix strassen_multiply(int size, const Matrix& A, const Matrix& B) {
-    int new_size = 1;
-    while (new_size < size) {
-        new_size *= 2;
-    }
-
-    Matrix A_padded = allocateMatrix(new_size);
-    Matrix B_padded = allocateMatrix(new_size);
-
-    for (int i = 0; i < new_size; i++) {
-        for (int j = 0; j < new_size; j++) {
-            if (i < size && j < size) {
-                A_padded[i][j] = A[i][j];
-                B_padded[i][j] = B[i][j];
-            } else {
-                A_padded[i][j] = 0;
-                B_padded[i][j] = 0;
-            }
-        }
-    }
-
-    Matrix C_padded = strassen_multiply_internal(new_size, A_padded, B_padded);
-
-    Matrix C_result = allocateMatrix(size);
-    for (int i = 0; i < size; i++) {
-        for (int j = 0; j < size; j++) {
-            C_result[i][j] = C_padded[i][j];
-        }
-    }
-
-    return C_result;
-}
-
-unsigned long long getMemoryUsage(int size) {
-    // Suponiendo que cada valor en la matriz ocupa 4 bytes (int)
-    return sizeof(int) * size * size * 3; // Tres matrices: A, B y C
-}
-
-int main() {
-    int size;
-    cout << "ALGORITMO DE STRASSEN PARA MULTIPLICACIÓN DE MATRICES\n";
-    cout << "-------------------------------------------------------\n";
-    cout << "Ingrese el tamaño N para las matrices cuadradas (NxN): ";
-    cin >> size;
-
-    if (size <= 0) {
-        cout << "Tamaño no válido.\n";
-        return 1;
-    }
-
-    Matrix A = allocateMatrix(size);
-    Matrix B = allocateMatrix(size);
-
-    fillRandomMatrix(size, A);
-    fillRandomMatrix(size, B);
-
-    auto start = high_resolution_clock::now();
-    Matrix C = strassen_multiply(size, A, B);
-    auto stop = high_resolution_clock::now();
-
-    auto duration = duration_cast<milliseconds>(stop - start);
-    cout << "Tiempo de ejecución (Strassen): " << duration.count() << " ms\n";
-
-    // Calcular la memoria utilizada
-    unsigned long long memory_used_bytes = getMemoryUsage(size);
-    cout << "Memoria utilizada: " << memory_used_bytes << " bytes (" 
-         << (double)memory_used_bytes / 1024.0 << " KB / "
-         << (double)memory_used_bytes / (1024.0 * 1024.0) << " MB)" << endl;
-
-    return 0;
-}
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <chrono>
+
+#include "Autotune.hpp"
+#include "Chain.hpp"
+#include "ElementType.hpp"
+#include "Matrix.hpp"
+#include "MatrixFile.hpp"
+#include "MatrixIO.hpp"
+#include "MemoryTracker.hpp"
+#include "OutOfCore.hpp"
+#include "RandomMatrix.hpp"
+#include "Simd.hpp"
+#include "Sparse.hpp"
+#include "Strassen.hpp"
+#include "StrassenProfile.hpp"
+#include "ThreadPool.hpp"
+#include "Verify.hpp"
+
+using namespace std;
+using namespace chrono;
+
+// --- Funciones Auxiliares (Comunes) ---
+template <typename T>
+Matrix<T> allocateMatrix(int size) {
+    if (size < 0) return {};
+    return Matrix<T>(size, size); // Inicializa una matriz NxN con 0 (buffer contiguo y alineado)
+}
+
+
+void printBytes(const string& label, size_t bytes) {
+    cout << label << ": " << bytes << " bytes (" << (double)bytes / 1024.0 << " KB / "
+         << (double)bytes / (1024.0 * 1024.0) << " MB)\n";
+}
+
+// Memoria medida (MemoryTracker.hpp): pico de bytes vivos de matrices y arena,
+// reservas hechas por la multiplicación y pico de RSS del proceso. Con
+// partial, parte de la memoria (los arrays de Sparse.hpp, en std::vector) no
+// pasa por MemoryTracker y solo la refleja el RSS
+void printMemoryReport(const MemoryReport& mem, bool partial = false) {
+    printBytes(partial ? "Memoria utilizada (pico medido, parcial)" : "Memoria utilizada (pico medido)",
+               mem.peakBytes);
+    printBytes("  Extra durante la multiplicación", mem.peakExtraBytes());
+    cout << "  Reservas durante la multiplicación: " << mem.allocations << "\n";
+    if (partial) cout << "  (sin los arrays CSR/CSC ni los búferes de los kernels dispersos; ver el RSS)\n";
+    printBytes(mem.rssReset ? "RSS máximo durante la multiplicación (getrusage)" : "RSS máximo del proceso (getrusage)",
+               mem.peakRss);
+}
+
+// Perfil por nivel y fase (solo con -DSTRASSEN_PROFILE, ver StrassenProfile.hpp);
+// jsonPath no vacío lo guarda además en JSON
+void printStrassenProfile(const string& jsonPath) {
+#ifdef STRASSEN_PROFILE
+    StrassenProfiler::instance().report(cout);
+    if (!jsonPath.empty()) {
+        ofstream out(jsonPath);
+        StrassenProfiler::instance().reportJson(out);
+        cout << "Perfil guardado en " << jsonPath << "\n";
+    }
+#else
+    if (!jsonPath.empty()) cout << "Perfil no disponible: compilar con -DSTRASSEN_PROFILE\n";
+#endif
+}
+
+// Archivo de matriz n x n con enteros 0-9 de la semilla seed, escrito por
+// franjas de filas que se sueltan del proceso al terminarlas: no necesita n²
+// en RAM, y el contenido es el mismo que fillRandomMatrix sobre la matriz entera
+template <typename T>
+void writeRandomMatrixFile(const string& path, int n, uint64_t seed) {
+    MappedMatrix<T> file = MappedMatrix<T>::create(path, n, n);
+    MatrixView<T> m = file.view();
+    const int band = 256;
+    for (int i0 = 0; i0 < n; i0 += band) {
+        int rows = min(band, n - i0);
+        fillRandomMatrix<T>(m.block(i0, 0, rows, n), seed, 0, i0);
+        file.adviseBlock(i0, 0, rows, n, MADV_DONTNEED);
+    }
+    file.flush();
+}
+
+// Deja distinta de 0 solo una fracción density de A, por bloques de tile x
+// tile (1: elemento a elemento) elegidos con Philox de (seed, which). Con
+// tile potencia de 2 los cuadrantes vacíos de Strassen salen enteros
+template <typename T>
+void sparsifyMatrix(MatrixView<T> A, double density, int tile, uint64_t seed, uint32_t which) {
+    int tileRows = (A.rows() + tile - 1) / tile, tileCols = (A.cols() + tile - 1) / tile;
+    vector<uint32_t> words(tileCols);
+    double limit = density * 4294967296.0;
+    for (int r = 0; r < tileRows; r++) {
+        // Un flujo por fila de bloques, aparte de los de Verify.hpp y estimateDensity
+        randomWords(words.data(), tileCols, seed, 0x80000000u | which << 30 | (uint32_t)r);
+        int i0 = r * tile, rows = min(tile, A.rows() - i0);
+        for (int c = 0; c < tileCols; c++) {
+            if (words[c] < limit) continue;
+            int j0 = c * tile, cols = min(tile, A.cols() - j0);
+            for (int i = i0; i < i0 + rows; i++) fill(A[i] + j0, A[i] + j0 + cols, T(0));
+        }
+    }
+}
+
+// C = A * B desde archivos (OutOfCore.hpp); C se crea con el tipo Acc
+template <typename T, typename Acc>
+int runOutOfCore(const string& pathA, const string& pathB, const string& pathC, ElementType type) {
+    MappedMatrix<T> A = MappedMatrix<T>::open(pathA), B = MappedMatrix<T>::open(pathB);
+    MappedMatrix<Acc> C = MappedMatrix<Acc>::create(pathC, A.rows(), B.cols());
+    size_t budget = outOfCoreBudget();
+
+    MemoryMeasurement memory;
+    auto start = high_resolution_clock::now();
+    OutOfCoreReport report = outOfCoreMultiply<T, Acc>(A, B, C, budget);
+    auto stop = high_resolution_clock::now();
+    MemoryReport mem = memory.finish();
+
+    cout << "Multiplicación fuera de memoria: " << A.rows() << "x" << A.cols() << " * " << B.rows() << "x"
+         << B.cols() << " -> " << pathC << "\n";
+    cout << "Tipo de elemento: " << elementTypeName(type) << "\n";
+    cout << "Hilos: " << defaultThreadPool().size() << "\n";
+    printBytes("Presupuesto de memoria", budget);
+    cout << "Tile: " << report.tile << "x" << report.tile << " (" << report.tiles << " productos de tile)\n";
+    printBytes("Memoria de trabajo de los tiles", report.tileBytes);
+    cout << "Tiempo de ejecución (fuera de memoria): " << duration_cast<milliseconds>(stop - start).count()
+         << " ms\n";
+    printMemoryReport(mem);
+    return 0;
+}
+
+// Referencia para --chain: la cadena en el orden escrito, ((A1 * A2) * A3) * ...
+template <typename T, typename Acc>
+Matrix<Acc> leftToRightChain(const vector<MatrixView<const T>>& mats) {
+    Matrix<Acc> P(mats[0].rows(), mats[0].cols());
+    for (int i = 0; i < P.rows(); i++) copy(mats[0][i], mats[0][i] + P.cols(), P[i]);
+    for (size_t k = 1; k < mats.size(); k++) {
+        Matrix<Acc> next(P.rows(), mats[k].cols());
+        if constexpr (is_same_v<T, Acc>) {
+            multiply_into<Acc, Acc>(next, P, mats[k]);
+        } else {
+            Matrix<Acc> wide(mats[k].rows(), mats[k].cols());
+            for (int i = 0; i < wide.rows(); i++) copy(mats[k][i], mats[k][i] + wide.cols(), wide[i]);
+            multiply_into<Acc, Acc>(next, P, wide);
+        }
+        P = std::move(next);
+    }
+    return P;
+}
+
+// Cadena A1 * ... * An aleatoria con dims (Ai es dims[i] x dims[i + 1]):
+// muestra los paréntesis elegidos (Chain.hpp) y compara tiempo y resultado
+// con el orden escrito
+template <typename T, typename Acc>
+int runChain(const vector<int>& dims, ElementType type, const string& output, uint64_t seed) {
+    MatrixChainPlan plan(dims);
+    vector<Matrix<T>> owned;
+    vector<MatrixView<const T>> mats;
+    for (int i = 0; i < plan.length(); i++) {
+        owned.emplace_back(dims[i], dims[i + 1]);
+        fillRandomMatrix<T>(owned.back().view(), seed, (uint32_t)i);
+    }
+    for (const Matrix<T>& m : owned) mats.push_back(m);
+    cout << "Cadena de " << plan.length() << " matrices (semilla " << seed << "), tipo " << elementTypeName(type)
+         << "\n";
+    cout << "Paréntesis elegidos: " << plan.toString() << "\n";
+    cout << "Coste estimado: " << plan.cost() << " (orden escrito: " << plan.leftToRightCost() << ", "
+         << plan.leftToRightCost() / max(plan.cost(), 1.0) << " veces más)\n";
+
+    MemoryMeasurement memory;
+    auto start = high_resolution_clock::now();
+    Matrix<Acc> C = chain_multiply<T, Acc>(mats);
+    auto stop = high_resolution_clock::now();
+    MemoryReport mem = memory.finish();
+    cout << "Tiempo (paréntesis elegidos): " << duration<double, milli>(stop - start).count() << " ms\n";
+    printBytes("Arena de intermedios", chain_workspace_size<T, Acc>(plan));
+    printMemoryReport(mem);
+
+    start = high_resolution_clock::now();
+    Matrix<Acc> reference = leftToRightChain<T, Acc>(mats);
+    stop = high_resolution_clock::now();
+    cout << "Tiempo (orden escrito): " << duration<double, milli>(stop - start).count() << " ms\n";
+    double maxError = 0;
+    for (int i = 0; i < C.rows(); i++) {
+        for (int j = 0; j < C.cols(); j++) {
+            double r = (double)reference[i][j], c = (double)C[i][j];
+            maxError = max(maxError, fabs(r - c) / max(1.0, fabs(r)));
+        }
+    }
+    bool same = is_integral_v<Acc> ? maxError == 0 : maxError < 1e-3;
+    cout << "Resultado frente al orden escrito: " << (same ? "coincide" : "DIFIERE") << " (error relativo máximo "
+         << maxError << ")\n";
+    if (!output.empty()) {
+        saveMatrix<Acc>(output, C);
+        cout << "Matriz resultado guardada en " << output << "\n";
+    }
+    return same ? 0 : 1;
+}
+
+// Genera A y B, las multiplica y reporta métricas con elementos T y acumulación
+// Acc. A y B salen de los archivos de inputs (MatrixIO.hpp) o son aleatorias de
+// size x size con la semilla seed (y, con density < 1, dispersas en bloques de
+// densityBlock); con sparseAware el producto elige entre el motor denso y el
+// disperso (Sparse.hpp). C se guarda en output si se indicó y, con
+// verifyRounds > 0, se comprueba con Freivalds (Verify.hpp)
+template <typename T, typename Acc>
+int runStrassen(int size, ElementType type, const string& profileJson, const vector<string>& inputs,
+                const string& output, uint64_t seed, int verifyRounds, double density, int densityBlock,
+                bool sparseAware) {
+    MatrixSource<T> A, B;
+    if (inputs.empty()) {
+        Matrix<T> randomA = allocateMatrix<T>(size);
+        Matrix<T> randomB = allocateMatrix<T>(size);
+        fillRandomMatrix<T>(randomA.view(), seed, 0);
+        fillRandomMatrix<T>(randomB.view(), seed, 1);
+        cout << "Semilla de A y B: " << seed << "\n";
+        if (density < 1) {
+            sparsifyMatrix<T>(randomA.view(), density, densityBlock, seed, 0);
+            sparsifyMatrix<T>(randomB.view(), density, densityBlock, seed, 1);
+            cout << "Densidad de A y B: " << density << " (bloques de " << densityBlock << "x" << densityBlock
+                 << ")\n";
+        }
+        A = MatrixSource<T>(std::move(randomA));
+        B = MatrixSource<T>(std::move(randomB));
+    } else {
+        A = MatrixSource<T>::load(inputs[0]);
+        B = MatrixSource<T>::load(inputs[1]);
+        if (A.cols() != B.rows()) {
+            cout << "Dimensiones incompatibles: A es " << A.rows() << "x" << A.cols() << " y B es " << B.rows()
+                 << "x" << B.cols() << ".\n";
+            return 1;
+        }
+        cout << "A (" << A.rows() << "x" << A.cols() << ") y B (" << B.rows() << "x" << B.cols() << ") cargadas"
+             << (A.mapped() && B.mapped() ? " (proyectadas sin copia)" : "") << "\n";
+    }
+
+    MemoryMeasurement memory;
+#ifdef STRASSEN_PROFILE
+    StrassenProfiler::instance().begin();
+#endif
+    SparseDispatch dispatch;
+    auto start = high_resolution_clock::now();
+    Matrix<Acc> C = sparseAware ? multiply_sparse_aware<T, Acc>(A, B, &dispatch)
+                                : strassen_multiply<T, Acc>(A.rows(), A.cols(), B.cols(), A, B);
+    auto stop = high_resolution_clock::now();
+#ifdef STRASSEN_PROFILE
+    StrassenProfiler::instance().end();
+#endif
+    MemoryReport mem = memory.finish();
+
+    auto duration = duration_cast<milliseconds>(stop - start);
+    cout << "Kernel SIMD: " << simdIsaName(simdKernels().isa) << "\n";
+    cout << "Hilos: " << defaultThreadPool().size() << "\n";
+    cout << "Tipo de elemento: " << elementTypeName(type) << "\n";
+    cout << "Umbral de Strassen: " << strassenThreshold() << "\n";
+    cout << "Variante: " << strassenVariantName(strassenVariant()) << "\n";
+    if (sparseAware) {
+        cout << "Densidad estimada: A " << dispatch.densityA << ", B " << dispatch.densityB << "\n";
+        cout << "Ruta: " << multiplyRouteName(dispatch.route) << " (coste estimado " << dispatch.sparseCost
+             << " disperso frente a " << dispatch.denseCost << " denso)\n";
+    }
+    cout << "Tiempo de ejecución (" << (sparseAware ? "despacho por densidad" : "Strassen") << "): "
+         << duration.count() << " ms\n";
+
+    printMemoryReport(mem, sparseAware && dispatch.route != MultiplyRoute::Dense);
+    printStrassenProfile(profileJson);
+    if (!output.empty()) {
+        saveMatrix<Acc>(output, C);
+        cout << "Matriz C guardada en " << output << "\n";
+    }
+    if (verifyRounds > 0) {
+        auto verifyStart = steady_clock::now();
+        VerifyReport check = freivaldsVerify<T, Acc>(A, B, C, verifyRounds, seed);
+        chrono::duration<double, milli> verifyTime = steady_clock::now() - verifyStart;
+        printVerifyReport(cout, check, verifyTime.count());
+        if (!check.ok) return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    // Opciones: --threads N     (hilos del pool; por defecto MATMUL_THREADS o todos los núcleos)
+    //           --autotune [N] (mide umbral y bloques hasta N, por defecto 2048, y los guarda)
+    //           --winograd     (variante Strassen-Winograd: 15 sumas en lugar de 18)
+    //           --type T       (int32, int32-acc64, int64, float, double; ver ElementType.hpp)
+    //           --profile-json F (con -DSTRASSEN_PROFILE, guarda el perfil por nivel en F)
+    //           --out-of-core A B C (C = A * B desde archivos de matriz, tile a tile)
+    //           --budget MB    (memoria para --out-of-core; por defecto MATMUL_OOC_BUDGET_MB o 256)
+    //           --random-file N F (escribe en F una matriz aleatoria N x N del tipo --type y --seed)
+    //           --input A B    (lee A y B de archivos en lugar de generarlas; ver MatrixIO.hpp)
+    //           --output C     (guarda el resultado: .txt/.csv como texto, si no en binario)
+    //           --seed S       (semilla de las matrices aleatorias; por defecto, aleatoria)
+    //           --verify [R]   (comprueba C con R rondas de Freivalds; por defecto 2)
+    //           --chain d0,d1,...,dn (cadena aleatoria de n matrices di x di+1 con el mejor orden)
+    //           --density D [S] (A y B aleatorias con una fracción D de no nulos, en bloques de S x S)
+    //           --sparse       (elige entre el motor denso y el disperso según la densidad; ver Sparse.hpp)
+    ElementType type = ElementType::Int32;
+    string profileJson;
+    vector<string> outOfCore;
+    int randomSize = 0;
+    string randomPath;
+    vector<string> inputs;
+    string output;
+    uint64_t seed = random_device{}();
+    int verifyRounds = 0;
+    vector<int> chainDims;
+    double density = 1;
+    int densityBlock = 1;
+    bool sparseAware = false;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            setDefaultThreadCount(atoi(argv[++i]));
+        } else if (arg == "--type" && i + 1 < argc) {
+            if (!parseElementType(argv[++i], type)) {
+                cout << "Tipo no válido: " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (arg == "--out-of-core" && i + 3 < argc) {
+            outOfCore = {argv[i + 1], argv[i + 2], argv[i + 3]};
+            i += 3;
+        } else if (arg == "--budget" && i + 1 < argc) {
+            outOfCoreBudget() = (size_t)max(1, atoi(argv[++i])) * 1024 * 1024;
+        } else if (arg == "--random-file" && i + 2 < argc) {
+            randomSize = atoi(argv[i + 1]);
+            randomPath = argv[i + 2];
+            i += 2;
+        } else if (arg == "--input" && i + 2 < argc) {
+            inputs = {argv[i + 1], argv[i + 2]};
+            i += 2;
+        } else if (arg == "--output" && i + 1 < argc) {
+            output = argv[++i];
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--verify") {
+            // Número de rondas opcional
+            verifyRounds = (i + 1 < argc && isdigit((unsigned char)argv[i + 1][0])) ? atoi(argv[++i])
+                                                                                   : VERIFY_DEFAULT_ROUNDS;
+        } else if (arg == "--chain" && i + 1 < argc) {
+            string list = argv[++i];
+            for (size_t p = 0; p < list.size();) {
+                size_t comma = list.find(',', p);
+                if (comma == string::npos) comma = list.size();
+                chainDims.push_back(atoi(list.substr(p, comma - p).c_str()));
+                p = comma + 1;
+            }
+        } else if (arg == "--density" && i + 1 < argc) {
+            density = min(1.0, max(0.0, atof(argv[++i])));
+            // Lado de bloque opcional
+            if (i + 1 < argc && isdigit((unsigned char)argv[i + 1][0])) densityBlock = max(1, atoi(argv[++i]));
+        } else if (arg == "--sparse") {
+            sparseAware = true;
+        } else if (arg == "--profile-json" && i + 1 < argc) {
+            profileJson = argv[++i];
+        } else if (arg == "--winograd") {
+            strassenVariant() = StrassenVariant::Winograd;
+        } else if (arg == "--autotune") {
+            int maxSize = (i + 1 < argc) ? atoi(argv[i + 1]) : 0;
+            autotune(maxSize > 0 ? maxSize : 2048, cout);
+            return 0;
+        }
+    }
+
+    // Lanza la multiplicación con el tipo elegido; los errores de archivo se informan
+    auto run = [&](int size) {
+        try {
+            return dispatchElementType(type, [&](auto t, auto acc) {
+                return runStrassen<decltype(t), decltype(acc)>(size, type, profileJson, inputs, output, seed, verifyRounds,
+                                                              density, densityBlock, sparseAware);
+            });
+        } catch (const exception& e) {
+            cout << e.what() << "\n";
+            return 1;
+        }
+    };
+
+    try {
+        if (randomSize > 0) {
+            dispatchElementType(type, [&](auto t, auto) {
+                writeRandomMatrixFile<decltype(t)>(randomPath, randomSize, seed);
+                return 0;
+            });
+            cout << "Matriz aleatoria " << randomSize << "x" << randomSize << " (semilla " << seed << ") guardada en "
+                 << randomPath << "\n";
+            return 0;
+        }
+        if (!chainDims.empty()) {
+            return dispatchElementType(type, [&](auto t, auto acc) {
+                return runChain<decltype(t), decltype(acc)>(chainDims, type, output, seed);
+            });
+        }
+        if (!outOfCore.empty()) {
+            return dispatchElementType(type, [&](auto t, auto acc) {
+                return runOutOfCore<decltype(t), decltype(acc)>(outOfCore[0], outOfCore[1], outOfCore[2], type);
+            });
+        }
+    } catch (const exception& e) {
+        cout << e.what() << "\n";
+        return 1;
+    }
+
+    int size;
+    cout << "ALGORITMO DE STRASSEN PARA MULTIPLICACIÓN DE MATRICES\n";
+    cout << "-------------------------------------------------------\n";
+    if (!inputs.empty()) return run(0);
+    cout << "Ingrese el tamaño N para las matrices cuadradas (NxN): ";
+    cin >> size;
+
+    if (size <= 0) {
+        cout << "Tamaño no válido.\n";
+        return 1;
+    }
+
+    return run(size);
+}
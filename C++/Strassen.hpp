@@ -0,0 +1,692 @@
+#ifndef STRASSEN_HPP
+#define STRASSEN_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include "Gemm.hpp"
+#include "Matrix.hpp"
+#include "MatrixExpr.hpp"
+#include "Simd.hpp"
+#include "SmallGemm.hpp"
+#include "StrassenProfile.hpp"
+#include "ThreadPool.hpp"
+#include "Tuning.hpp"
+#include "Workspace.hpp"
+
+#define STRASSEN_THRESHOLD 64 // Umbral por defecto para cambiar a algoritmo ingenuo
+
+// Umbral en uso: STRASSEN_THRESHOLD del entorno, si no el archivo de tuning
+// (strassen_threshold, lo escribe --autotune), si no el valor por defecto
+inline int& strassenThreshold() {
+    static int threshold = tunedInt("STRASSEN_THRESHOLD", "strassen_threshold", STRASSEN_THRESHOLD);
+    return threshold;
+}
+
+// Strassen para matrices rectangulares C (M x N) = A (M x K) * B (K x N).
+// En cada nivel se recurre sobre la parte par (2*floor(M/2), 2*floor(K/2),
+// 2*floor(N/2)) y la fila/columna impar sobrante se corrige con productos
+// delgados del motor por bloques. No hay padding global a potencia de 2:
+// N = 1025 cuesta lo que cuesta 1024 más una franja de ancho 1.
+
+// --- Operaciones elemento a elemento (dimensiones tomadas de C) ---
+
+// Bytes de los elementos de una vista (para el perfil de tráfico de memoria)
+template <typename T>
+size_t elementBytes(MatrixView<T> C) {
+    return (size_t)C.rows() * C.cols() * sizeof(T);
+}
+
+// Bytes mínimos que mueve un producto: leer A y B, escribir C (y leerlo si acumula)
+template <typename T>
+size_t productBytes(int M, int K, int N, bool accumulate) {
+    return ((size_t)M * K + (size_t)K * N + (size_t)M * N * (accumulate ? 2 : 1)) * sizeof(T);
+}
+
+// Suma/resta fila a fila: int32 con el kernel SIMD elegido al arrancar
+// (Simd.hpp); los demás tipos con el bucle escalar, que el compilador vectoriza
+template <typename T>
+void addMatrices(MatrixView<const T> A, MatrixView<const T> B, MatrixView<T> C) {
+    STRASSEN_PROFILE_PHASE(ProfilePhase::AddSub, 3 * elementBytes(C));
+    void (*add)(int, const T*, const T*, T*) = addRowScalar<T>;
+    if constexpr (std::is_same_v<T, int>) add = simdKernels().addInt32;
+    for (int i = 0; i < C.rows(); i++) {
+        add(C.cols(), A[i], B[i], C[i]);
+    }
+}
+
+template <typename T>
+void subtractMatrices(MatrixView<const T> A, MatrixView<const T> B, MatrixView<T> C) {
+    STRASSEN_PROFILE_PHASE(ProfilePhase::AddSub, 3 * elementBytes(C));
+    void (*sub)(int, const T*, const T*, T*) = subRowScalar<T>;
+    if constexpr (std::is_same_v<T, int>) sub = simdKernels().subInt32;
+    for (int i = 0; i < C.rows(); i++) {
+        sub(C.cols(), A[i], B[i], C[i]);
+    }
+}
+
+// C = alpha * P + beta * C en una pasada (P puede ser el propio C). Con
+// beta = 0 no se lee C, así que su contenido previo no importa.
+template <typename T>
+void scaleAddMatrices(T alpha, MatrixView<const T> P, T beta, MatrixView<T> C) {
+    STRASSEN_PROFILE_PHASE(ProfilePhase::AddSub, (beta == T(0) ? 2 : 3) * elementBytes(C));
+    for (int i = 0; i < C.rows(); i++) {
+        const T* p = P[i];
+        T* c = C[i];
+        if (beta == T(0)) {
+            for (int j = 0; j < C.cols(); j++) c[j] = alpha * p[j];
+        } else {
+            for (int j = 0; j < C.cols(); j++) c[j] = alpha * p[j] + beta * c[j];
+        }
+    }
+}
+
+// C = e, una expresión de sumas y restas (MatrixExpr.hpp), en una sola
+// pasada: lee cada operando una vez y escribe C una vez
+template <typename T, typename E>
+void combineMatrices(MatrixView<T> C, const MatrixExpr<E>& e) {
+    STRASSEN_PROFILE_PHASE(ProfilePhase::AddSub, (E::operands + 1) * elementBytes(C));
+    C = e;
+}
+
+// true si la vista es toda ceros. Se detiene en el primer elemento distinto
+// de 0, así que con datos densos cuesta unas pocas lecturas
+template <typename T>
+bool isZeroMatrix(MatrixView<const T> A) {
+    for (int i = 0; i < A.rows(); i++) {
+        const T* row = A[i];
+        for (int j = 0; j < A.cols(); j++) {
+            if (row[j] != T(0)) return false;
+        }
+    }
+    return true;
+}
+
+// true si la vista no tiene Inf ni NaN (con enteros, siempre)
+template <typename T>
+bool isFiniteMatrix(MatrixView<const T> A) {
+    if constexpr (std::is_integral_v<T>) {
+        return true;
+    } else {
+        for (int i = 0; i < A.rows(); i++) {
+            const T* row = A[i];
+            for (int j = 0; j < A.cols(); j++) {
+                if (!std::isfinite(row[j])) return false;
+            }
+        }
+        return true;
+    }
+}
+
+// true si A * B es exactamente 0: un operando todo ceros y el otro sin Inf
+// ni NaN, que en IEEE darían 0 * Inf = NaN. Solo recorre el otro operando
+// entero cuando el primero es todo ceros
+template <typename T>
+bool isZeroProduct(MatrixView<const T> A, MatrixView<const T> B) {
+    return (isZeroMatrix<T>(A) && isFiniteMatrix<T>(B)) || (isZeroMatrix<T>(B) && isFiniteMatrix<T>(A));
+}
+
+template <typename T>
+void zeroMatrix(MatrixView<T> C) {
+    STRASSEN_PROFILE_PHASE(ProfilePhase::Copy, elementBytes(C));
+    for (int i = 0; i < C.rows(); i++) std::fill(C[i], C[i] + C.cols(), T(0));
+}
+
+template <typename T>
+void copyMatrix(MatrixView<const T> A, MatrixView<T> C) {
+    STRASSEN_PROFILE_PHASE(ProfilePhase::Copy, 2 * elementBytes(C));
+    for (int i = 0; i < C.rows(); i++) {
+        std::copy(A[i], A[i] + C.cols(), C[i]);
+    }
+}
+
+// Paralelismo de Strassen: en los primeros niveles los 7 productos se lanzan
+// como tareas en el pool; por debajo de parallelDepth niveles o de
+// parallelMinSize la recursión sigue en serie dentro de cada tarea.
+struct StrassenParallelConfig {
+    int parallelDepth = 2;
+    int parallelMinSize = 512;
+};
+
+inline StrassenParallelConfig& strassenParallelConfig() {
+    static StrassenParallelConfig config;
+    return config;
+}
+
+// Variante de los niveles en serie: la clásica (7 productos, 18 sumas) o la
+// de Winograd (7 productos, 15 sumas). Por defecto STRASSEN_VARIANT o la clásica.
+enum class StrassenVariant { Classic, Winograd };
+
+inline const char* strassenVariantName(StrassenVariant variant) {
+    return variant == StrassenVariant::Winograd ? "Winograd" : "Clásica";
+}
+
+inline StrassenVariant& strassenVariant() {
+    static StrassenVariant variant = [] {
+        const char* v = std::getenv("STRASSEN_VARIANT");
+        return (v != nullptr && std::strcmp(v, "winograd") == 0) ? StrassenVariant::Winograd : StrassenVariant::Classic;
+    }();
+    return variant;
+}
+
+// Un nivel se divide solo si las tres dimensiones superan el umbral
+inline bool strassen_is_base(int M, int K, int N) {
+    return std::min(M, std::min(K, N)) <= std::max(1, strassenThreshold());
+}
+
+inline bool strassen_runs_parallel(int M, int K, int N, int depth) {
+    const StrassenParallelConfig& cfg = strassenParallelConfig();
+    return !strassen_is_base(M, K, N) && depth < cfg.parallelDepth &&
+           std::min(M, std::min(K, N)) >= cfg.parallelMinSize && defaultThreadPool().size() > 1;
+}
+
+// Caso base: si el corte cae en un tamaño con kernel fijo (4, 8, 16 o 32,
+// SmallGemm.hpp), ese kernel sin empaquetado; si no, el motor por bloques
+template <typename T>
+void naive_multiply_strassen_base(MatrixView<const T> A, MatrixView<const T> B, MatrixView<T> C,
+                                  bool accumulate = false) {
+    if (isFixedGemmSize(A.rows(), A.cols(), B.cols())) {
+        smallGemm<T>(A, B, C, accumulate);
+    } else {
+        gemm<T>(A, B, C, accumulate);
+    }
+}
+
+// Temporales de un nivel paralelo: 10 operandos sumados (P1, P6 y P7 usan
+// dos; P2..P5 uno) y 4 productos (P1..P3 se escriben directamente en C).
+#define STRASSEN_PARALLEL_TEMPS_A 5 // m2 x k2
+#define STRASSEN_PARALLEL_TEMPS_B 5 // k2 x n2
+#define STRASSEN_PARALLEL_TEMPS_P 4 // m2 x n2
+
+// Bytes de arena de strassen_multiply_internal para un subproblema M x K x N
+// en el nivel depth. Un nivel en serie reutiliza 3 temporales y la misma arena
+// para los 7 hijos; uno paralelo necesita 14 temporales y una región por hijo.
+// En Winograd, los dos productos que se acumulan en C necesitan además un
+// resultado intermedio si el hijo no es caso base (ver strassen_multiply_accumulate).
+template <typename T>
+size_t strassen_internal_workspace_size(int M, int K, int N, int depth) {
+    if (strassen_is_base(M, K, N)) return 0;
+    int m2 = M / 2, k2 = K / 2, n2 = N / 2;
+    size_t matA = Workspace::matrixBytes<T>(m2, k2);
+    size_t matB = Workspace::matrixBytes<T>(k2, n2);
+    size_t matP = Workspace::matrixBytes<T>(m2, n2);
+    size_t child = strassen_internal_workspace_size<T>(m2, k2, n2, depth + 1);
+    if (strassen_runs_parallel(M, K, N, depth)) {
+        return STRASSEN_PARALLEL_TEMPS_A * matA + STRASSEN_PARALLEL_TEMPS_B * matB +
+               STRASSEN_PARALLEL_TEMPS_P * matP + 7 * Workspace::alignUp(child);
+    }
+    if (strassenVariant() == StrassenVariant::Winograd && !strassen_is_base(m2, k2, n2)) {
+        return matA + matB + matP + matP + child;
+    }
+    return matA + matB + matP + child;
+}
+
+// Bytes de arena que necesita strassen_multiply<T, Acc> para A (M x K) * B (K x N)
+// con la configuración actual de hilos. Permite reservar una sola arena y
+// reutilizarla en muchas multiplicaciones. Si Acc es más ancho que T, incluye
+// las copias ampliadas de A y B.
+template <typename T = int, typename Acc = T>
+size_t strassen_workspace_size(int M, int K, int N) {
+    size_t inner = strassen_internal_workspace_size<Acc>(M, K, N, 0);
+    if (std::is_same_v<T, Acc> || inner == 0) return inner;
+    return Workspace::matrixBytes<Acc>(M, K) + Workspace::matrixBytes<Acc>(K, N) + inner;
+}
+
+template <typename T = int, typename Acc = T>
+size_t strassen_workspace_size(int size) {
+    return strassen_workspace_size<T, Acc>(size, size, size);
+}
+
+template <typename T>
+void strassen_parallel_level(MatrixView<const T> A, MatrixView<const T> B, MatrixView<T> C, Workspace& ws, int depth);
+template <typename T>
+void winograd_level(MatrixView<const T> A, MatrixView<const T> B, MatrixView<T> C, Workspace& ws, int depth);
+
+// Corrige la fila/columna impar que la recursión sobre la parte par no cubre.
+// C ya contiene A[:2m2, :2k2] * B[:2k2, :2n2] en su bloque par.
+template <typename T>
+void strassen_fixup_odd(MatrixView<const T> A, MatrixView<const T> B, MatrixView<T> C) {
+    int M = A.rows(), K = A.cols(), N = B.cols();
+    int me = M / 2 * 2, ke = K / 2 * 2, ne = N / 2 * 2;
+    if (me == M && ke == K && ne == N) return;
+    STRASSEN_PROFILE_PHASE(ProfilePhase::Fixup, productBytes<T>(M, K, N, false) - productBytes<T>(me, ke, ne, false));
+    if (ke < K) { // Columna sobrante de A por fila sobrante de B (actualización de rango 1)
+        gemm<T>(A.block(0, ke, me, 1), B.block(ke, 0, 1, ne), C.block(0, 0, me, ne), true);
+    }
+    if (ne < N) { // Última columna de C completa
+        gemm<T>(A.block(0, 0, me, K), B.block(0, ne, K, 1), C.block(0, ne, me, 1));
+    }
+    if (me < M) { // Última fila de C completa
+        gemm<T>(A.block(me, 0, 1, K), B, C.block(me, 0, 1, N));
+    }
+}
+
+// Calcula C = A * B trabajando sobre vistas: los cuadrantes son solo
+// desplazamiento + stride dentro de los buffers padre, y cada producto
+// P1..P7 se acumula directamente en los cuadrantes de C.
+// C no debe solaparse con A ni con B. Los temporales salen de la arena ws.
+// depth es el nivel de recursión (0 arriba), usado para decidir el paralelismo.
+template <typename T>
+void strassen_multiply_internal(MatrixView<const T> A, MatrixView<const T> B, MatrixView<T> C, Workspace& ws,
+                                int depth = 0) {
+    STRASSEN_PROFILE_LEVEL(depth);
+    int M = A.rows(), K = A.cols(), N = B.cols();
+    // Un operando todo ceros (p. ej. un cuadrante vacío de una entrada
+    // dispersa, o la suma de dos): C = 0 sin recurrir ni multiplicar, salvo
+    // que el otro tenga Inf o NaN, que deben llegar a C como en gemm
+    if (isZeroProduct<T>(A, B)) {
+        zeroMatrix<T>(C);
+        return;
+    }
+    if (strassen_is_base(M, K, N)) {
+        STRASSEN_PROFILE_PHASE(ProfilePhase::Base, productBytes<T>(M, K, N, false));
+        naive_multiply_strassen_base<T>(A, B, C);
+        return;
+    }
+    if (strassen_runs_parallel(M, K, N, depth)) {
+        strassen_parallel_level<T>(A, B, C, ws, depth);
+        strassen_fixup_odd<T>(A, B, C);
+        return;
+    }
+    if (strassenVariant() == StrassenVariant::Winograd) {
+        winograd_level<T>(A, B, C, ws, depth);
+        return;
+    }
+
+    int m2 = M / 2, k2 = K / 2, n2 = N / 2;
+
+    // Submatrices (vistas, sin copia)
+    MatrixView<const T> A11 = A.block(0, 0, m2, k2), A12 = A.block(0, k2, m2, k2);
+    MatrixView<const T> A21 = A.block(m2, 0, m2, k2), A22 = A.block(m2, k2, m2, k2);
+    MatrixView<const T> B11 = B.block(0, 0, k2, n2), B12 = B.block(0, n2, k2, n2);
+    MatrixView<const T> B21 = B.block(k2, 0, k2, n2), B22 = B.block(k2, n2, k2, n2);
+    MatrixView<T> C11 = C.block(0, 0, m2, n2), C12 = C.block(0, n2, m2, n2);
+    MatrixView<T> C21 = C.block(m2, 0, m2, n2), C22 = C.block(m2, n2, m2, n2);
+
+    // Temporary matrices: operandos sumados y un producto intermedio (en la arena)
+    WorkspaceScope scope(ws);
+    STRASSEN_PROFILE_START(temps, ProfilePhase::Alloc, productBytes<T>(m2, k2, n2, false));
+    MatrixView<T> tempA = ws.allocateMatrix<T>(m2, k2), tempB = ws.allocateMatrix<T>(k2, n2);
+    MatrixView<T> P = ws.allocateMatrix<T>(m2, n2);
+    STRASSEN_PROFILE_STOP(temps);
+
+    // P1 = (A11 + A22) * (B11 + B22) -> C11 = P1, C22 = P1
+    addMatrices<T>(A11, A22, tempA);
+    addMatrices<T>(B11, B22, tempB);
+    strassen_multiply_internal<T>(tempA, tempB, C11, ws, depth + 1);
+    copyMatrix<T>(C11, C22);
+
+    // P2 = (A21 + A22) * B11 -> C21 = P2, C22 -= P2
+    addMatrices<T>(A21, A22, tempA);
+    strassen_multiply_internal<T>(tempA, B11, C21, ws, depth + 1);
+    subtractMatrices<T>(C22, C21, C22);
+
+    // P3 = A11 * (B12 - B22) -> C12 = P3, C22 += P3
+    subtractMatrices<T>(B12, B22, tempB);
+    strassen_multiply_internal<T>(A11, tempB, C12, ws, depth + 1);
+    addMatrices<T>(C22, C12, C22);
+
+    // P4 = A22 * (B21 - B11) -> C11 += P4, C21 += P4
+    subtractMatrices<T>(B21, B11, tempB);
+    strassen_multiply_internal<T>(A22, tempB, P, ws, depth + 1);
+    addMatrices<T>(C11, P, C11);
+    addMatrices<T>(C21, P, C21);
+
+    // P5 = (A11 + A12) * B22 -> C11 -= P5, C12 += P5
+    addMatrices<T>(A11, A12, tempA);
+    strassen_multiply_internal<T>(tempA, B22, P, ws, depth + 1);
+    subtractMatrices<T>(C11, P, C11);
+    addMatrices<T>(C12, P, C12);
+
+    // P6 = (A21 - A11) * (B11 + B12) -> C22 += P6
+    subtractMatrices<T>(A21, A11, tempA);
+    addMatrices<T>(B11, B12, tempB);
+    strassen_multiply_internal<T>(tempA, tempB, P, ws, depth + 1);
+    addMatrices<T>(C22, P, C22);
+
+    // P7 = (A12 - A22) * (B21 + B22) -> C11 += P7
+    subtractMatrices<T>(A12, A22, tempA);
+    addMatrices<T>(B21, B22, tempB);
+    strassen_multiply_internal<T>(tempA, tempB, P, ws, depth + 1);
+    addMatrices<T>(C11, P, C11);
+
+    strassen_fixup_odd<T>(A, B, C);
+}
+
+// C += A * B. En el caso base la suma se hace dentro del microkernel (sin
+// pasada extra); si no, el producto va a un temporal y luego se suma.
+template <typename T>
+void strassen_multiply_accumulate(MatrixView<const T> A, MatrixView<const T> B, MatrixView<T> C, Workspace& ws,
+                                  int depth) {
+    if (isZeroProduct<T>(A, B)) return; // C += 0
+    if (strassen_is_base(A.rows(), A.cols(), B.cols())) {
+        STRASSEN_PROFILE_LEVEL(depth);
+        STRASSEN_PROFILE_PHASE(ProfilePhase::Base, productBytes<T>(A.rows(), A.cols(), B.cols(), true));
+        naive_multiply_strassen_base<T>(A, B, C, true);
+        return;
+    }
+    WorkspaceScope scope(ws);
+    STRASSEN_PROFILE_START(temp, ProfilePhase::Alloc, elementBytes(C));
+    MatrixView<T> W = ws.allocateMatrix<T>(C.rows(), C.cols());
+    STRASSEN_PROFILE_STOP(temp);
+    strassen_multiply_internal<T>(A, B, W, ws, depth);
+    addMatrices<T>(C, W, C);
+}
+
+// Evalúa el operando en tmp si es una combinación X +/- Y; si no, lo devuelve tal cual
+template <typename T>
+MatrixView<const T> materializeOperand(const GemmOperand<T>& op, MatrixView<T> tmp) {
+    if (op.sign == 0) return op.x;
+    if (op.sign > 0) {
+        addMatrices<T>(op.x, op.y, tmp);
+    } else {
+        subtractMatrices<T>(op.x, op.y, tmp);
+    }
+    return tmp;
+}
+
+// Producto de un nivel de Winograd: C (+)= a * b. Si el hijo es caso base, la
+// suma de operandos se fusiona en el empaquetado de GEMM y la acumulación en
+// el microkernel (con operandos directos, el caso base normal, que puede usar
+// un kernel fijo); si no, los operandos se escriben en tmpA/tmpB y se recurre.
+template <typename T>
+void winograd_product(const GemmOperand<T>& a, MatrixView<T> tmpA, const GemmOperand<T>& b, MatrixView<T> tmpB,
+                      MatrixView<T> C, Workspace& ws, int depth, bool accumulate) {
+    if (strassen_is_base(a.rows(), a.cols(), b.cols())) {
+        STRASSEN_PROFILE_LEVEL(depth);
+        STRASSEN_PROFILE_PHASE(ProfilePhase::Base, productBytes<T>(a.rows(), a.cols(), b.cols(), accumulate));
+        if (a.sign == 0 && b.sign == 0) {
+            naive_multiply_strassen_base<T>(a.x, b.x, C, accumulate);
+        } else {
+            gemmFused<T>(a, b, C, accumulate);
+        }
+        return;
+    }
+    MatrixView<const T> x = materializeOperand<T>(a, tmpA);
+    MatrixView<const T> y = materializeOperand<T>(b, tmpB);
+    if (accumulate) {
+        strassen_multiply_accumulate<T>(x, y, C, ws, depth);
+    } else {
+        strassen_multiply_internal<T>(x, y, C, ws, depth);
+    }
+}
+
+// Un nivel de Strassen-Winograd (7 productos, 15 sumas) con 3 temporales:
+// X (operandos de A), Y (operandos de B) y Z (P1). Los productos se escriben
+// en los cuadrantes de C y las sumas U1..U7 se hacen en su lugar.
+//   S1 = A21 + A22   S2 = S1 - A11   S3 = A11 - A21   S4 = A12 - S2
+//   T1 = B12 - B11   T2 = B22 - T1   T3 = B22 - B12   T4 = T2 - B21
+//   P1 = A11 B11  P2 = A12 B21  P3 = S4 B22  P4 = A22 T4
+//   P5 = S1 T1    P6 = S2 T2    P7 = S3 T3
+//   C11 = P1 + P2            C12 = P1 + P6 + P5 + P3
+//   C21 = P1 + P6 + P7 - P4  C22 = P1 + P6 + P7 + P5
+template <typename T>
+void winograd_level(MatrixView<const T> A, MatrixView<const T> B, MatrixView<T> C, Workspace& ws, int depth) {
+    using Op = GemmOperand<T>;
+    int m2 = A.rows() / 2, k2 = A.cols() / 2, n2 = B.cols() / 2;
+    int d = depth + 1;
+    MatrixView<const T> A11 = A.block(0, 0, m2, k2), A12 = A.block(0, k2, m2, k2);
+    MatrixView<const T> A21 = A.block(m2, 0, m2, k2), A22 = A.block(m2, k2, m2, k2);
+    MatrixView<const T> B11 = B.block(0, 0, k2, n2), B12 = B.block(0, n2, k2, n2);
+    MatrixView<const T> B21 = B.block(k2, 0, k2, n2), B22 = B.block(k2, n2, k2, n2);
+    MatrixView<T> C11 = C.block(0, 0, m2, n2), C12 = C.block(0, n2, m2, n2);
+    MatrixView<T> C21 = C.block(m2, 0, m2, n2), C22 = C.block(m2, n2, m2, n2);
+
+    WorkspaceScope scope(ws);
+    STRASSEN_PROFILE_START(temps, ProfilePhase::Alloc, productBytes<T>(m2, k2, n2, false));
+    MatrixView<T> X = ws.allocateMatrix<T>(m2, k2), Y = ws.allocateMatrix<T>(k2, n2);
+    MatrixView<T> Z = ws.allocateMatrix<T>(m2, n2);
+    STRASSEN_PROFILE_STOP(temps);
+
+    // P7 = S3 * T3 -> C21 (S3 y T3 no se reutilizan: se fusionan si el hijo es base)
+    winograd_product<T>(Op(A11, A21, -1), X, Op(B22, B12, -1), Y, C21, ws, d, false);
+
+    // P5 = S1 * T1 -> C22 (S1 y T1 quedan en X/Y para S2 y T2)
+    addMatrices<T>(A21, A22, X);
+    subtractMatrices<T>(B12, B11, Y);
+    winograd_product<T>(Op(X), X, Op(Y), Y, C22, ws, d, false);
+
+    // P6 = S2 * T2 -> C12 (S2 y T2 quedan en X/Y para S4 y T4)
+    subtractMatrices<T>(X, A11, X);
+    subtractMatrices<T>(B22, Y, Y);
+    winograd_product<T>(Op(X), X, Op(Y), Y, C12, ws, d, false);
+
+    // P1 -> Z, P2 -> C11 (operandos directos: X/Y no se tocan)
+    winograd_product<T>(Op(A11), X, Op(B11), Y, Z, ws, d, false);
+    winograd_product<T>(Op(A12), X, Op(B21), Y, C11, ws, d, false);
+
+    addMatrices<T>(C11, Z, C11);   // C11 = U1 = P1 + P2
+    addMatrices<T>(C12, Z, C12);   // U2 = P1 + P6
+    addMatrices<T>(C21, C12, C21); // U3 = U2 + P7
+    addMatrices<T>(C12, C22, C12); // U4 = U2 + P5
+    addMatrices<T>(C22, C21, C22); // C22 = U7 = U3 + P5
+
+    // C12 = U5 = U4 + S4 * B22, acumulando P3 directamente en C12
+    winograd_product<T>(Op(A12, X, -1), X, Op(B22), Y, C12, ws, d, true);
+
+    // C21 = U6 = U3 - A22 * T4 = U3 + A22 * (B21 - T2), acumulando en C21
+    winograd_product<T>(Op(A22), X, Op(B21, Y, -1), Y, C21, ws, d, true);
+
+    strassen_fixup_odd<T>(A, B, C);
+}
+
+// Un nivel de Strassen con los 7 productos como tareas del pool. Cada tarea
+// prepara sus propios operandos y recibe una región de arena exclusiva para su
+// recursión, así que los hilos no compiten por los temporales.
+// Solo cubre la parte par; la fila/columna impar la corrige quien llama.
+template <typename T>
+void strassen_parallel_level(MatrixView<const T> A, MatrixView<const T> B, MatrixView<T> C, Workspace& ws, int depth) {
+    int m2 = A.rows() / 2, k2 = A.cols() / 2, n2 = B.cols() / 2;
+    MatrixView<const T> A11 = A.block(0, 0, m2, k2), A12 = A.block(0, k2, m2, k2);
+    MatrixView<const T> A21 = A.block(m2, 0, m2, k2), A22 = A.block(m2, k2, m2, k2);
+    MatrixView<const T> B11 = B.block(0, 0, k2, n2), B12 = B.block(0, n2, k2, n2);
+    MatrixView<const T> B21 = B.block(k2, 0, k2, n2), B22 = B.block(k2, n2, k2, n2);
+    MatrixView<T> C11 = C.block(0, 0, m2, n2), C12 = C.block(0, n2, m2, n2);
+    MatrixView<T> C21 = C.block(m2, 0, m2, n2), C22 = C.block(m2, n2, m2, n2);
+
+    WorkspaceScope scope(ws);
+    STRASSEN_PROFILE_START(temps, ProfilePhase::Alloc,
+                           (STRASSEN_PARALLEL_TEMPS_A * (size_t)m2 * k2 + STRASSEN_PARALLEL_TEMPS_B * (size_t)k2 * n2 +
+                            STRASSEN_PARALLEL_TEMPS_P * (size_t)m2 * n2) * sizeof(T));
+    auto tempA = [&] { return ws.allocateMatrix<T>(m2, k2); };
+    auto tempB = [&] { return ws.allocateMatrix<T>(k2, n2); };
+    auto tempP = [&] { return ws.allocateMatrix<T>(m2, n2); };
+    MatrixView<T> S1a = tempA(), S2 = tempA(), S5 = tempA(), S6a = tempA(), S7a = tempA();
+    MatrixView<T> S1b = tempB(), S3 = tempB(), S4 = tempB(), S6b = tempB(), S7b = tempB();
+    MatrixView<T> P4 = tempP(), P5 = tempP(), P6 = tempP(), P7 = tempP();
+
+    size_t childBytes = Workspace::alignUp(strassen_internal_workspace_size<T>(m2, k2, n2, depth + 1));
+    void* regions[7];
+    for (void*& region : regions) region = ws.allocateBytes(childBytes);
+    STRASSEN_PROFILE_STOP(temps);
+
+    // Cada producto se multiplica sobre su región de arena exclusiva
+    auto product = [=](int i, MatrixView<const T> X, MatrixView<const T> Y, MatrixView<T> out) {
+        Workspace local(regions[i], childBytes);
+        strassen_multiply_internal<T>(X, Y, out, local, depth + 1);
+    };
+
+    TaskGroup group(defaultThreadPool());
+    group.run([=] {
+        STRASSEN_PROFILE_LEVEL(depth);
+        addMatrices<T>(A11, A22, S1a);
+        addMatrices<T>(B11, B22, S1b);
+        product(0, S1a, S1b, C11); // P1
+    });
+    group.run([=] {
+        STRASSEN_PROFILE_LEVEL(depth);
+        addMatrices<T>(A21, A22, S2);
+        product(1, S2, B11, C21); // P2
+    });
+    group.run([=] {
+        STRASSEN_PROFILE_LEVEL(depth);
+        subtractMatrices<T>(B12, B22, S3);
+        product(2, A11, S3, C12); // P3
+    });
+    group.run([=] {
+        STRASSEN_PROFILE_LEVEL(depth);
+        subtractMatrices<T>(B21, B11, S4);
+        product(3, A22, S4, P4);
+    });
+    group.run([=] {
+        STRASSEN_PROFILE_LEVEL(depth);
+        addMatrices<T>(A11, A12, S5);
+        product(4, S5, B22, P5);
+    });
+    group.run([=] {
+        STRASSEN_PROFILE_LEVEL(depth);
+        subtractMatrices<T>(A21, A11, S6a);
+        addMatrices<T>(B11, B12, S6b);
+        product(5, S6a, S6b, P6);
+    });
+    group.run([=] {
+        STRASSEN_PROFILE_LEVEL(depth);
+        subtractMatrices<T>(A12, A22, S7a);
+        addMatrices<T>(B21, B22, S7b);
+        product(6, S7a, S7b, P7);
+    });
+    group.wait();
+
+    // C11, C21 y C12 contienen P1, P2 y P3; C22 se arma antes de modificarlos.
+    // Cada cuadrante se combina en una sola pasada (MatrixExpr.hpp)
+    combineMatrices<T>(C22, C11 - C21 + C12 + P6); // C22 = P1 - P2 + P3 + P6
+    combineMatrices<T>(C11, C11 + P4 - P5 + P7);   // C11 = P1 + P4 - P5 + P7
+    combineMatrices<T>(C12, C12 + P5);             // C12 = P3 + P5
+    combineMatrices<T>(C21, C21 + P4);             // C21 = P2 + P4
+}
+
+// C (M x N) = A (M x K) * B (K x N) sin reservar memoria: los temporales salen
+// de ws, que debe tener al menos strassen_workspace_size<T, Acc>(M, K, N) bytes
+// libres. Con Acc más ancho que T (p. ej. int32 -> int64), A y B se amplían una
+// vez en la arena y toda la recursión trabaja en Acc, así que ni los productos
+// ni las sumas intermedias de operandos desbordan T.
+template <typename T, typename Acc = T>
+void strassen_multiply(MatrixView<const T> A, MatrixView<const T> B, MatrixView<Acc> C, Workspace& ws) {
+    if constexpr (std::is_same_v<T, Acc>) {
+        strassen_multiply_internal<T>(A, B, C, ws);
+    } else {
+        int M = A.rows(), K = A.cols(), N = B.cols();
+        if (strassen_is_base(M, K, N)) {
+            gemm<T, Acc>(A, B, C);
+            return;
+        }
+        WorkspaceScope scope(ws);
+        MatrixView<Acc> wideA = ws.allocateMatrix<Acc>(M, K), wideB = ws.allocateMatrix<Acc>(K, N);
+        STRASSEN_PROFILE_START(widen, ProfilePhase::Copy,
+                               ((size_t)M * K + (size_t)K * N) * (sizeof(T) + sizeof(Acc)));
+        for (int i = 0; i < M; i++) std::copy(A[i], A[i] + K, wideA[i]);
+        for (int i = 0; i < K; i++) std::copy(B[i], B[i] + N, wideB[i]);
+        STRASSEN_PROFILE_STOP(widen);
+        strassen_multiply_internal<Acc>(wideA, wideB, C, ws);
+    }
+}
+
+template <typename T, typename Acc = T>
+Matrix<Acc> strassen_multiply(int M, int K, int N, MatrixView<const T> A, MatrixView<const T> B) {
+    size_t wsBytes = strassen_workspace_size<T, Acc>(M, K, N);
+    STRASSEN_PROFILE_START(buffers, ProfilePhase::Alloc, wsBytes + (size_t)M * N * sizeof(Acc));
+    Workspace ws(wsBytes);
+    Matrix<Acc> C(M, N);
+    STRASSEN_PROFILE_STOP(buffers);
+    strassen_multiply<T, Acc>(A.block(0, 0, M, K), B.block(0, 0, K, N), C, ws);
+    return C;
+}
+
+template <typename T, typename Acc = T>
+Matrix<Acc> strassen_multiply(int size, MatrixView<const T> A, MatrixView<const T> B) {
+    return strassen_multiply<T, Acc>(size, size, size, A, B);
+}
+
+// Multiplicación general C (M x N) = A (M x K) * B (K x N): Strassen cuando
+// las tres dimensiones dan para al menos un nivel de recursión, y el motor
+// por bloques en paralelo para formas pequeñas o muy delgadas.
+template <typename T, typename Acc = T>
+Matrix<Acc> multiply(int M, int K, int N, MatrixView<const T> A, MatrixView<const T> B) {
+    if (strassen_is_base(M, K, N)) {
+        Matrix<Acc> C(M, N);
+        gemmParallel<T, Acc>(A.block(0, 0, M, K), B.block(0, 0, K, N), C, defaultThreadPool());
+        return C;
+    }
+    return strassen_multiply<T, Acc>(M, K, N, A, B);
+}
+
+// --- Producto sobre almacenamiento del llamador (semántica GEMM) ---
+
+// Arena que necesita multiply_into para C (M x N) = alpha * A * B + beta * C:
+// la de Strassen más un temporal M x N para el producto cuando beta != 0
+template <typename T, typename Acc = T>
+size_t multiply_into_workspace_size(int M, int K, int N) {
+    return strassen_workspace_size<T, Acc>(M, K, N) + Workspace::matrixBytes<Acc>(M, N);
+}
+
+// C = alpha * A * B + beta * C escribiendo en C (del llamador) sin reservar:
+// los temporales salen de ws (al menos multiply_into_workspace_size bytes).
+// Con beta = 0, el producto va directamente a C; si además alpha != 1 se
+// escala en una pasada. Con beta != 0, el producto va a un temporal de la
+// arena y una sola pasada forma alpha * P + beta * C, salvo alpha = beta = 1
+// con caso base, que acumula en el microkernel. Strassen o motor por bloques
+// en paralelo según la forma, como multiply. C no debe solaparse con A ni B.
+template <typename T, typename Acc = T>
+void multiply_into(MatrixView<Acc> C, MatrixView<const T> A, MatrixView<const T> B, Acc alpha, Acc beta,
+                   Workspace& ws) {
+    int M = A.rows(), K = A.cols(), N = B.cols();
+    if (alpha == Acc(0) || K == 0) { // Sin producto: solo C = beta * C
+        // Con beta = 0 no se lee C (como en BLAS): un NaN o Inf previo no queda en C
+        if (beta == Acc(0)) {
+            zeroMatrix<Acc>(C);
+        } else if (beta != Acc(1)) {
+            scaleAddMatrices<Acc>(beta, C, Acc(0), C);
+        }
+        return;
+    }
+    bool base = strassen_is_base(M, K, N);
+    auto product = [&](MatrixView<Acc> P, bool accumulate) {
+        if (base) {
+            gemmParallel<T, Acc>(A, B, P, defaultThreadPool(), accumulate);
+        } else {
+            strassen_multiply<T, Acc>(A, B, P, ws);
+        }
+    };
+
+    if (beta == Acc(0)) {
+        product(C, false);
+        if (alpha != Acc(1)) scaleAddMatrices<Acc>(alpha, C, Acc(0), C);
+        return;
+    }
+    if (base && alpha == Acc(1) && beta == Acc(1)) {
+        product(C, true);
+        return;
+    }
+    WorkspaceScope scope(ws);
+    STRASSEN_PROFILE_START(temp, ProfilePhase::Alloc, elementBytes(C));
+    MatrixView<Acc> P = ws.allocateMatrix<Acc>(M, N);
+    STRASSEN_PROFILE_STOP(temp);
+    product(P, false);
+    scaleAddMatrices<Acc>(alpha, P, beta, C);
+}
+
+// Arena del hilo para multiply_into sin ws explícita: crece cuando una
+// llamada necesita más y se conserva, así un bucle que multiplica una y otra
+// vez sobre los mismos buffers no vuelve a reservar memoria
+inline Workspace& multiplyIntoWorkspace(size_t bytes) {
+    thread_local std::unique_ptr<Workspace> ws;
+    if (!ws || ws->capacity() < bytes) {
+        ws.reset(); // Libera la anterior antes de reservar la nueva
+        ws = std::make_unique<Workspace>(bytes);
+    }
+    return *ws;
+}
+
+template <typename T, typename Acc = T>
+void multiply_into(MatrixView<Acc> C, MatrixView<const T> A, MatrixView<const T> B, Acc alpha = Acc(1),
+                   Acc beta = Acc(0)) {
+    Workspace& ws = multiplyIntoWorkspace(multiply_into_workspace_size<T, Acc>(A.rows(), A.cols(), B.cols()));
+    multiply_into<T, Acc>(C, A, B, alpha, beta, ws);
+}
+
+#endif
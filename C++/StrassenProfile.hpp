@@ -0,0 +1,303 @@
+#ifndef STRASSEN_PROFILE_HPP
+#define STRASSEN_PROFILE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstdlib>
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Instrumentación de Strassen, desactivada por defecto: solo se compila con
+// -DSTRASSEN_PROFILE. Registra tiempo, llamadas y bytes movidos por nivel de
+// recursión y por fase (caso base, sumas/restas, copias, reserva de
+// temporales, corrección de impares) y, en Linux, contadores de hardware con
+// perf_event_open (ciclos, instrucciones, fallos de LLC). Sin la macro, los
+// puntos de medición no generan código.
+
+enum class ProfilePhase { Base, AddSub, Copy, Alloc, Fixup, Count };
+
+inline const char* profilePhaseName(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::Base: return "caso base";
+        case ProfilePhase::AddSub: return "sumas/restas";
+        case ProfilePhase::Copy: return "copias";
+        case ProfilePhase::Alloc: return "temporales";
+        default: return "impares";
+    }
+}
+
+constexpr int PROFILE_MAX_LEVELS = 32;
+constexpr int PROFILE_PHASES = (int)ProfilePhase::Count;
+
+// Contadores de hardware del proceso. perf_event_open con pid = 0 solo mide
+// el hilo que llama (e inherit, los que cree después), y el pool suele
+// existir ya al empezar la sesión; así que start abre los contadores en cada
+// hilo de /proc/self/task y stop suma sus cuentas. Los hilos creados después
+// de start se cuentan por herencia desde el que los crea. available() es false
+// si el kernel no los permite en algún hilo (p. ej. perf_event_paranoid alto
+// o contenedores sin PMU).
+class PerfCounters {
+public:
+    static constexpr int COUNT = 3;
+
+    static const char* name(int i) {
+        static const char* names[COUNT] = {"ciclos", "instrucciones", "fallos de LLC"};
+        return names[i];
+    }
+
+    ~PerfCounters() { close(); }
+
+    void start() {
+        close();
+#ifdef __linux__
+        const uint64_t configs[COUNT] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                         PERF_COUNT_HW_CACHE_MISSES};
+        std::vector<pid_t> threads = processThreads();
+        for (int i = 0; i < COUNT; i++) {
+            perf_event_attr attr = {};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = configs[i];
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            available_[i] = !threads.empty();
+            for (pid_t tid : threads) {
+                int fd = (int)syscall(__NR_perf_event_open, &attr, tid, -1, -1, 0);
+                if (fd < 0) {
+                    if (errno != ESRCH) available_[i] = false; // ESRCH: el hilo ya terminó
+                    continue;
+                }
+                fds_[i].push_back(fd);
+            }
+            if (!available_[i]) continue;
+            for (int fd : fds_[i]) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    void stop() {
+#ifdef __linux__
+        for (int i = 0; i < COUNT; i++) {
+            if (!available_[i]) continue;
+            for (int fd : fds_[i]) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            values_[i] = 0;
+            for (int fd : fds_[i]) {
+                uint64_t value = 0;
+                if (read(fd, &value, sizeof(value)) == (ssize_t)sizeof(value)) values_[i] += value;
+            }
+        }
+#endif
+    }
+
+    bool available(int i) const { return available_[i]; }
+    uint64_t value(int i) const { return values_[i]; }
+
+private:
+#ifdef __linux__
+    // Identificadores de los hilos vivos del proceso
+    static std::vector<pid_t> processThreads() {
+        std::vector<pid_t> threads;
+        DIR* dir = opendir("/proc/self/task");
+        if (dir == nullptr) return {(pid_t)syscall(SYS_gettid)};
+        while (dirent* entry = readdir(dir)) {
+            if (entry->d_name[0] != '.') threads.push_back((pid_t)atoi(entry->d_name));
+        }
+        closedir(dir);
+        return threads;
+    }
+#endif
+
+    void close() {
+        for (int i = 0; i < COUNT; i++) {
+#ifdef __linux__
+            for (int fd : fds_[i]) ::close(fd);
+#endif
+            fds_[i].clear();
+            available_[i] = false;
+            values_[i] = 0;
+        }
+    }
+
+    std::vector<int> fds_[COUNT]; // Uno por hilo
+    bool available_[COUNT] = {};
+    uint64_t values_[COUNT] = {};
+};
+
+// Acumuladores por (nivel, fase). Atómicos: los niveles paralelos registran
+// desde varios hilos, y el tiempo se suma por hilo (tiempo de CPU agregado).
+class StrassenProfiler {
+public:
+    static StrassenProfiler& instance() {
+        static StrassenProfiler profiler;
+        return profiler;
+    }
+
+    // Empieza una sesión: pone a cero los acumuladores y arranca los contadores
+    void begin() {
+        for (auto& level : cells_) {
+            for (Cell& c : level) c.calls = c.nanos = c.bytes = 0;
+        }
+        perf_.start();
+        start_ = std::chrono::steady_clock::now();
+    }
+
+    void end() {
+        wallNanos_ = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - start_).count();
+        perf_.stop();
+    }
+
+    void record(int level, ProfilePhase phase, uint64_t nanos, uint64_t bytes) {
+        level = level < 0 ? 0 : (level >= PROFILE_MAX_LEVELS ? PROFILE_MAX_LEVELS - 1 : level);
+        Cell& c = cells_[level][(int)phase];
+        c.calls.fetch_add(1, std::memory_order_relaxed);
+        c.nanos.fetch_add(nanos, std::memory_order_relaxed);
+        c.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    // Nivel de recursión del hilo actual (lo fija StrassenProfileLevel)
+    static int& currentLevel() {
+        thread_local int level = 0;
+        return level;
+    }
+
+    // Tabla por nivel y fase, totales por fase y contadores de hardware
+    void report(std::ostream& out) const {
+        out << "--- Perfil de Strassen (tiempo sumado de todos los hilos) ---\n";
+        out << "Nivel\tFase\t\tLlamadas\tTiempo (ms)\tBytes (MB)\tGB/s\n";
+        uint64_t totalNanos[PROFILE_PHASES] = {}, totalBytes[PROFILE_PHASES] = {}, totalCalls[PROFILE_PHASES] = {};
+        for (int level = 0; level < PROFILE_MAX_LEVELS; level++) {
+            for (int p = 0; p < PROFILE_PHASES; p++) {
+                const Cell& c = cells_[level][p];
+                if (c.calls == 0) continue;
+                totalNanos[p] += c.nanos;
+                totalBytes[p] += c.bytes;
+                totalCalls[p] += c.calls;
+                out << level << "\t" << profilePhaseName((ProfilePhase)p) << "\t" << (p == 0 || p == 2 ? "\t" : "")
+                    << c.calls << "\t\t" << c.nanos / 1e6 << "\t\t" << c.bytes / 1048576.0 << "\t\t"
+                    << (c.nanos ? (double)c.bytes / c.nanos : 0.0) << "\n";
+            }
+        }
+        out << "Totales por fase:\n";
+        for (int p = 0; p < PROFILE_PHASES; p++) {
+            out << "  " << profilePhaseName((ProfilePhase)p) << ": " << totalCalls[p] << " llamadas, "
+                << totalNanos[p] / 1e6 << " ms, " << totalBytes[p] / 1048576.0 << " MB\n";
+        }
+        out << "Tiempo de pared de la sesión: " << wallNanos_ / 1e6 << " ms\n";
+        out << "Contadores de hardware (perf_event_open, todos los hilos):\n";
+        for (int i = 0; i < PerfCounters::COUNT; i++) {
+            out << "  " << PerfCounters::name(i) << ": ";
+            if (perf_.available(i)) out << perf_.value(i) << "\n";
+            else out << "no disponible\n";
+        }
+        if (perf_.available(0) && perf_.available(1) && perf_.value(0) > 0) {
+            out << "  IPC: " << (double)perf_.value(1) / perf_.value(0) << "\n";
+        }
+    }
+
+    // Mismo contenido en JSON
+    void reportJson(std::ostream& out) const {
+        out << "{\n  \"tiempo_pared_ms\": " << wallNanos_ / 1e6 << ",\n  \"contadores\": {";
+        bool first = true;
+        for (int i = 0; i < PerfCounters::COUNT; i++) {
+            if (!perf_.available(i)) continue;
+            out << (first ? "" : ", ") << "\"" << PerfCounters::name(i) << "\": " << perf_.value(i);
+            first = false;
+        }
+        out << "},\n  \"fases\": [\n";
+        first = true;
+        for (int level = 0; level < PROFILE_MAX_LEVELS; level++) {
+            for (int p = 0; p < PROFILE_PHASES; p++) {
+                const Cell& c = cells_[level][p];
+                if (c.calls == 0) continue;
+                out << (first ? "" : ",\n") << "    {\"nivel\": " << level << ", \"fase\": \""
+                    << profilePhaseName((ProfilePhase)p) << "\", \"llamadas\": " << c.calls
+                    << ", \"tiempo_ms\": " << c.nanos / 1e6 << ", \"bytes\": " << c.bytes << "}";
+                first = false;
+            }
+        }
+        out << "\n  ]\n}\n";
+    }
+
+private:
+    struct Cell {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> nanos{0};
+        std::atomic<uint64_t> bytes{0};
+    };
+
+    Cell cells_[PROFILE_MAX_LEVELS][PROFILE_PHASES];
+    PerfCounters perf_;
+    std::chrono::steady_clock::time_point start_;
+    uint64_t wallNanos_ = 0;
+};
+
+// Mide el ámbito actual (o hasta stop()) como una fase del nivel en curso
+class StrassenProfileScope {
+public:
+    StrassenProfileScope(ProfilePhase phase, uint64_t bytes)
+        : phase_(phase), bytes_(bytes), start_(std::chrono::steady_clock::now()) {}
+
+    ~StrassenProfileScope() { stop(); }
+
+    void stop() {
+        if (stopped_) return;
+        stopped_ = true;
+        auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+        StrassenProfiler::instance().record(StrassenProfiler::currentLevel(), phase_, (uint64_t)nanos.count(), bytes_);
+    }
+
+private:
+    ProfilePhase phase_;
+    uint64_t bytes_;
+    std::chrono::steady_clock::time_point start_;
+    bool stopped_ = false;
+};
+
+// Fija el nivel de recursión del hilo actual mientras dura el ámbito
+class StrassenProfileLevel {
+public:
+    explicit StrassenProfileLevel(int level) : saved_(StrassenProfiler::currentLevel()) {
+        StrassenProfiler::currentLevel() = level;
+    }
+    ~StrassenProfileLevel() { StrassenProfiler::currentLevel() = saved_; }
+
+private:
+    int saved_;
+};
+
+#define STRASSEN_PROFILE_CONCAT_(a, b) a##b
+#define STRASSEN_PROFILE_CONCAT(a, b) STRASSEN_PROFILE_CONCAT_(a, b)
+
+// Puntos de medición: PHASE mide hasta el final del ámbito, START/STOP un
+// tramo con nombre, LEVEL fija el nivel de recursión del hilo
+#ifdef STRASSEN_PROFILE
+#define STRASSEN_PROFILE_PHASE(phase, bytes) \
+    StrassenProfileScope STRASSEN_PROFILE_CONCAT(strassenProfileScope, __LINE__)(phase, bytes)
+#define STRASSEN_PROFILE_START(name, phase, bytes) StrassenProfileScope name(phase, bytes)
+#define STRASSEN_PROFILE_STOP(name) name.stop()
+#define STRASSEN_PROFILE_LEVEL(level) \
+    StrassenProfileLevel STRASSEN_PROFILE_CONCAT(strassenProfileLevel, __LINE__)(level)
+#else
+#define STRASSEN_PROFILE_PHASE(phase, bytes) ((void)0)
+#define STRASSEN_PROFILE_START(name, phase, bytes) ((void)0)
+#define STRASSEN_PROFILE_STOP(name) ((void)0)
+#define STRASSEN_PROFILE_LEVEL(level) ((void)0)
+#endif
+
+#endif
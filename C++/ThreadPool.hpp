@@ -0,0 +1,269 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Fija el hilo actual a una CPU: la index-ésima (módulo) de las que el proceso
+// tiene permitidas. Sin efecto fuera de Linux; false si no se pudo.
+inline bool pinCurrentThread(int index) {
+#ifdef __linux__
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return false;
+    int count = CPU_COUNT(&allowed);
+    if (count == 0) return false;
+    int target = index % count;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed) || target-- > 0) continue;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    }
+    return false;
+#else
+    (void)index;
+    return false;
+#endif
+}
+
+// Pool de hilos con robo de trabajo (work stealing): cada hilo tiene su propia
+// cola; saca tareas de su extremo (LIFO, datos calientes en caché) y, si se
+// queda sin trabajo, roba del extremo opuesto de las colas ajenas (FIFO,
+// tareas más grandes). El hilo que llama a TaskGroup::wait también ejecuta
+// tareas mientras espera, así que el paralelismo anidado no se bloquea.
+class ThreadPool {
+public:
+    // threads cuenta también al hilo externo que lanza el trabajo (cola 0).
+    // Con pin, cada worker i queda fijo en la CPU i y el hilo que crea el pool
+    // en la 0 (mediciones reproducibles, sin migraciones del planificador).
+    explicit ThreadPool(int threads, bool pin = false)
+        : size_(std::max(1, threads)), queues_(new WorkQueue[size_]) {
+        if (pin) pinCurrentThread(0);
+        for (int i = 1; i < size_; i++) {
+            workers_.emplace_back([this, i, pin] {
+                if (pin) pinCurrentThread(i);
+                workerLoop(i);
+            });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stop_ = true;
+        }
+        wakeup_.notify_all();
+        for (std::thread& t : workers_) t.join();
+    }
+
+    int size() const { return size_; }
+
+    void submit(std::function<void()> task) {
+        WorkQueue& q = queues_[currentQueue()];
+        {
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(std::move(task));
+        }
+        pending_.fetch_add(1);
+        // Tomar el mutex evita perder el aviso si un hilo está a punto de dormir
+        { std::lock_guard<std::mutex> lock(sleepMutex_); }
+        wakeup_.notify_one();
+    }
+
+    // Ejecuta una tarea pendiente (propia o robada). false si no había ninguna.
+    bool tryRunOne() {
+        std::function<void()> task;
+        int self = currentQueue();
+        if (!popLocal(self, task) && !steal(self, task)) return false;
+        pending_.fetch_sub(1);
+        task();
+        return true;
+    }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    // Cola del hilo actual: la propia si es un worker de este pool, si no la 0
+    int currentQueue() const {
+        return tlsPool() == this ? tlsIndex() : 0;
+    }
+
+    bool popLocal(int self, std::function<void()>& task) {
+        WorkQueue& q = queues_[self];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) return false;
+        task = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(int self, std::function<void()>& task) {
+        for (int offset = 1; offset < size_; offset++) {
+            WorkQueue& q = queues_[(self + offset) % size_];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.tasks.empty()) continue;
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(int index) {
+        tlsPool() = this;
+        tlsIndex() = index;
+        while (true) {
+            if (tryRunOne()) continue;
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            wakeup_.wait(lock, [this] { return stop_ || pending_.load() > 0; });
+            if (stop_ && pending_.load() == 0) return;
+        }
+    }
+
+    static const ThreadPool*& tlsPool() {
+        thread_local const ThreadPool* pool = nullptr;
+        return pool;
+    }
+
+    static int& tlsIndex() {
+        thread_local int index = 0;
+        return index;
+    }
+
+    int size_;
+    std::unique_ptr<WorkQueue[]> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<int> pending_{0};
+    std::mutex sleepMutex_;
+    std::condition_variable wakeup_;
+    bool stop_ = false;
+};
+
+// Grupo fork-join: run() lanza tareas al pool y wait() espera a todas,
+// ejecutando trabajo pendiente mientras tanto. Relanza la primera excepción.
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool) : pool_(pool) {}
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    ~TaskGroup() { waitAll(); }
+
+    template <typename F>
+    void run(F&& f) {
+        pending_.fetch_add(1);
+        pool_.submit([this, f = std::forward<F>(f)]() mutable {
+            try {
+                f();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex_);
+                if (!error_) error_ = std::current_exception();
+            }
+            pending_.fetch_sub(1);
+        });
+    }
+
+    void wait() {
+        waitAll();
+        if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+
+private:
+    void waitAll() {
+        while (pending_.load() > 0) {
+            if (!pool_.tryRunOne()) std::this_thread::yield();
+        }
+    }
+
+    ThreadPool& pool_;
+    std::atomic<int> pending_{0};
+    std::mutex errorMutex_;
+    std::exception_ptr error_;
+};
+
+// fn(first, last) sobre tramos de filas repartidos en el pool; tramos de al
+// menos ~64K elementos (rows * cols) para que compense lanzarlos. Con un solo
+// tramo, fn se llama en el hilo actual
+template <typename F>
+void parallelRows(ThreadPool& pool, int rows, int cols, F fn) {
+    long long work = (long long)rows * std::max(cols, 1);
+    int tasks = (int)std::min<long long>(pool.size(), std::max<long long>(1, work / 65536));
+    tasks = std::min(tasks, std::max(rows, 1));
+    if (tasks <= 1) {
+        fn(0, rows);
+        return;
+    }
+    TaskGroup group(pool);
+    for (int t = 0; t < tasks; t++) {
+        int first = (int)((long long)rows * t / tasks), last = (int)((long long)rows * (t + 1) / tasks);
+        group.run([=, &fn] { fn(first, last); });
+    }
+    group.wait();
+}
+
+// --- Pool compartido por los algoritmos ---
+
+// Hilos por defecto: MATMUL_THREADS o los que reporte el sistema
+inline int& defaultThreadCount() {
+    static int threads = [] {
+        if (const char* v = std::getenv("MATMUL_THREADS")) return std::max(1, std::atoi(v));
+        return std::max(1, (int)std::thread::hardware_concurrency());
+    }();
+    return threads;
+}
+
+// Fijar los hilos del pool a CPUs: MATMUL_PIN=1 o setDefaultThreadPinning
+inline bool& defaultThreadPinning() {
+    static bool pin = [] {
+        const char* v = std::getenv("MATMUL_PIN");
+        return v != nullptr && std::atoi(v) != 0;
+    }();
+    return pin;
+}
+
+inline std::unique_ptr<ThreadPool>& defaultPoolStorage() {
+    static std::unique_ptr<ThreadPool> pool;
+    return pool;
+}
+
+inline ThreadPool& defaultThreadPool() {
+    std::unique_ptr<ThreadPool>& pool = defaultPoolStorage();
+    if (!pool) pool.reset(new ThreadPool(defaultThreadCount(), defaultThreadPinning()));
+    return *pool;
+}
+
+// Cambia el número de hilos; llamar antes de lanzar trabajo (recrea el pool)
+inline void setDefaultThreadCount(int threads) {
+    defaultThreadCount() = std::max(1, threads);
+    defaultPoolStorage().reset();
+}
+
+inline void setDefaultThreadPinning(bool pin) {
+    defaultThreadPinning() = pin;
+    defaultPoolStorage().reset();
+}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef TUNING_HPP
+#define TUNING_HPP
+
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Archivo de tuning: líneas "clave=valor" (las que empiezan con # son
+// comentarios). Lo escribe el modo --autotune y se lee una vez al arrancar.
+// Ruta: MATMUL_TUNING_FILE o matmul_tuning.txt en el directorio actual.
+// Prioridad de cada parámetro: variable de entorno > archivo > valor por defecto.
+
+inline std::string tuningFilePath() {
+    if (const char* v = std::getenv("MATMUL_TUNING_FILE")) return v;
+    return "matmul_tuning.txt";
+}
+
+inline std::map<std::string, std::string> readTuningFile(const std::string& path) {
+    std::map<std::string, std::string> values;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) continue;
+        values[line.substr(0, eq)] = line.substr(eq + 1);
+    }
+    return values;
+}
+
+// Reescribe el archivo actualizando solo las claves dadas (conserva las demás,
+// p. ej. las que escribe la versión en C). false si no se pudo escribir.
+inline bool updateTuningFile(const std::string& path, const std::map<std::string, std::string>& updates) {
+    std::vector<std::string> lines;
+    {
+        std::ifstream in(path);
+        std::string line;
+        while (std::getline(in, line)) {
+            size_t eq = line.find('=');
+            if (line.empty() || line[0] == '#' || eq == std::string::npos || !updates.count(line.substr(0, eq))) {
+                lines.push_back(line);
+            }
+        }
+    }
+    std::ofstream out(path);
+    if (!out) return false;
+    for (const std::string& line : lines) out << line << "\n";
+    for (const auto& kv : updates) out << kv.first << "=" << kv.second << "\n";
+    return (bool)out;
+}
+
+// Valores cargados al arrancar (el archivo se lee una sola vez)
+inline const std::map<std::string, std::string>& tuningValues() {
+    static const std::map<std::string, std::string> values = readTuningFile(tuningFilePath());
+    return values;
+}
+
+// Entero para 'key': variable de entorno envVar, si no el archivo, si no fallback
+inline int tunedInt(const char* envVar, const std::string& key, int fallback) {
+    if (const char* v = std::getenv(envVar)) return std::atoi(v);
+    auto it = tuningValues().find(key);
+    if (it != tuningValues().end()) return std::atoi(it->second.c_str());
+    return fallback;
+}
+
+#endif
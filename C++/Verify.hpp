@@ -0,0 +1,172 @@
+#ifndef VERIFY_HPP
+#define VERIFY_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+#include "Matrix.hpp"
+#include "RandomMatrix.hpp"
+#include "ThreadPool.hpp"
+
+// Verificación de C = A * B con el algoritmo de Freivalds: para un vector
+// aleatorio r, A * (B * r) debe ser igual a C * r. Cada ronda cuesta tres
+// productos matriz-vector (O(n²)) en lugar de la multiplicación de
+// referencia (O(n³)); un C incorrecto pasa una ronda con probabilidad acotada
+// (como mucho 1/2 en el peor caso) y cada ronda independiente la multiplica.
+// Las filas i donde (C * r)[i] difiere de (A * (B * r))[i] son filas de C
+// con algún error: se informan.
+//
+// Enteros: se compara en aritmética modular sin signo del ancho de Acc, la
+// misma en la que el motor calcula (un desbordamiento da el mismo resto en
+// ambos lados), con r de 32 bits aleatorios. Coma flotante: r en [0, 1) y
+// tolerancia relativa al tamaño de los términos, |A| * (|B| * r), por un
+// factor que crece con K (verifyTolerance): cubre el error de redondeo del
+// motor por bloques y el mayor de Strassen-Winograd con umbrales pequeños.
+// Por eso en float solo se detectan errores de al menos un pequeño porcentaje
+// del valor de la celda; en double, errores mucho menores.
+
+constexpr int VERIFY_DEFAULT_ROUNDS = 2;  // Rondas por defecto
+constexpr int VERIFY_MAX_REPORTED_ROWS = 16; // Filas erróneas que se guardan
+
+struct VerifyReport {
+    bool ok = true;
+    int rounds = 0;
+    long long badRows = 0;      // Filas con error (en alguna ronda)
+    std::vector<int> firstBad;  // Primeras filas erróneas (hasta VERIFY_MAX_REPORTED_ROWS)
+};
+
+// Tolerancia en coma flotante, en unidades de eps * |A| * (|B| * r). Medido
+// con datos con signo: ~0.1 para el motor por bloques y hasta ~13 para
+// Strassen-Winograd 2048 con umbral 16, creciendo unas 2.4 veces por nivel
+template <typename Acc>
+double verifyTolerance(int K) {
+    return (16.0 + K / 32.0) * std::numeric_limits<Acc>::epsilon();
+}
+
+// Tipo en el que se hacen los productos matriz-vector de la verificación
+template <typename Acc, bool = std::is_integral_v<Acc>>
+struct VerifyScalarOf {
+    using type = std::make_unsigned_t<Acc>;
+};
+
+template <typename Acc>
+struct VerifyScalarOf<Acc, false> {
+    using type = double;
+};
+
+template <typename Acc>
+using VerifyScalar = typename VerifyScalarOf<Acc>::type;
+
+// out[i] = M[i] · v para i en [first, last), en aritmética S
+template <typename S, typename E>
+void verifyMatVec(MatrixView<const E> M, const S* v, S* out, int first, int last) {
+    int cols = M.cols();
+    for (int i = first; i < last; i++) {
+        const E* row = M[i];
+        S sum = 0;
+        for (int k = 0; k < cols; k++) sum += S(row[k]) * v[k];
+        out[i] = sum;
+    }
+}
+
+// Igual con valores absolutos: cota del tamaño de los términos (coma flotante)
+template <typename E>
+void verifyAbsMatVec(MatrixView<const E> M, const double* v, double* out, int first, int last) {
+    int cols = M.cols();
+    for (int i = first; i < last; i++) {
+        const E* row = M[i];
+        double sum = 0;
+        for (int k = 0; k < cols; k++) sum += std::fabs(double(row[k])) * v[k];
+        out[i] = sum;
+    }
+}
+
+// Comprueba C = A * B con rounds rondas de Freivalds (vectores r derivados de
+// seed, RandomMatrix.hpp) y los productos matriz-vector repartidos por filas
+// en el pool. A es M x K, B es K x N y C es M x N.
+template <typename T, typename Acc = T>
+VerifyReport freivaldsVerify(MatrixView<const T> A, MatrixView<const T> B, MatrixView<const Acc> C, int rounds,
+                             uint64_t seed, ThreadPool& pool) {
+    using S = VerifyScalar<Acc>;
+    int M = A.rows(), K = A.cols(), N = B.cols();
+    VerifyReport report;
+    report.rounds = rounds;
+    if (B.rows() != K || C.rows() != M || C.cols() != N) {
+        report.ok = false;
+        return report;
+    }
+
+    std::vector<S> r(N), br(K), abr(M), cr(M);
+    std::vector<double> absR, absBr, bound; // Solo coma flotante
+    if constexpr (!std::is_integral_v<Acc>) {
+        absR.resize(N);
+        absBr.resize(K);
+        bound.resize(M);
+    }
+    std::vector<char> bad(M, 0);
+    std::vector<uint32_t> words(N);
+
+    for (int round = 0; round < rounds; round++) {
+        // r: una fila de N palabras de 32 bits aleatorias (flujo = ronda)
+        randomWords(words.data(), N, seed, (uint32_t)round);
+        for (int j = 0; j < N; j++) {
+            if constexpr (std::is_integral_v<Acc>) r[j] = S(words[j]);
+            else r[j] = words[j] * (1.0 / 4294967296.0);
+        }
+        if constexpr (!std::is_integral_v<Acc>) {
+            for (int j = 0; j < N; j++) absR[j] = std::fabs(r[j]);
+        }
+
+        parallelRows(pool, K, N, [&](int first, int last) {
+            verifyMatVec<S, T>(B, r.data(), br.data(), first, last);
+            if constexpr (!std::is_integral_v<Acc>) verifyAbsMatVec<T>(B, absR.data(), absBr.data(), first, last);
+        });
+        parallelRows(pool, M, K + N, [&](int first, int last) {
+            verifyMatVec<S, T>(A, br.data(), abr.data(), first, last);
+            verifyMatVec<S, Acc>(C, r.data(), cr.data(), first, last);
+            if constexpr (std::is_integral_v<Acc>) {
+                for (int i = first; i < last; i++) bad[i] |= cr[i] != abr[i];
+            } else {
+                verifyAbsMatVec<T>(A, absBr.data(), bound.data(), first, last);
+                double tolerance = verifyTolerance<Acc>(K);
+                for (int i = first; i < last; i++) {
+                    double tol = tolerance * bound[i] + std::numeric_limits<double>::min();
+                    bad[i] |= !(std::fabs(cr[i] - abr[i]) <= tol);
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < M; i++) {
+        if (!bad[i]) continue;
+        report.badRows++;
+        if ((int)report.firstBad.size() < VERIFY_MAX_REPORTED_ROWS) report.firstBad.push_back(i);
+    }
+    report.ok = report.badRows == 0;
+    return report;
+}
+
+template <typename T, typename Acc = T>
+VerifyReport freivaldsVerify(MatrixView<const T> A, MatrixView<const T> B, MatrixView<const Acc> C,
+                             int rounds = VERIFY_DEFAULT_ROUNDS, uint64_t seed = 1) {
+    return freivaldsVerify<T, Acc>(A, B, C, rounds, seed, defaultThreadPool());
+}
+
+// Resultado de la verificación en una línea (y las primeras filas erróneas)
+inline void printVerifyReport(std::ostream& out, const VerifyReport& report, double ms) {
+    out << "Verificación (Freivalds, " << report.rounds << " rondas, " << ms << " ms): ";
+    if (report.ok) {
+        out << "correcta\n";
+        return;
+    }
+    out << "ERRÓNEA en " << report.badRows << " filas; primeras:";
+    for (int row : report.firstBad) out << " " << row;
+    out << "\n";
+}
+
+#endif
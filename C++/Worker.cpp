@@ -0,0 +1,268 @@
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <algorithm>
+#include <cctype>
+#include <csignal>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "ElementType.hpp"
+#include "MatrixFile.hpp"
+#include "RandomMatrix.hpp"
+#include "ThreadPool.hpp"
+#include "Verify.hpp"
+#include "Worker.hpp"
+
+using namespace std;
+
+// Daemon de multiplicación (Worker.hpp) y generador de carga local para medir
+// su latencia por trabajo (p50/p99) en la misma máquina.
+
+struct LoadOptions {
+    string socketPath = WORKER_DEFAULT_SOCKET;
+    ElementType type = ElementType::Int32;
+    int size = 256;
+    int jobs = 200;       // Trabajos medidos, repartidos entre los clientes
+    int clients = 1;      // Conexiones concurrentes, cada una con sus matrices
+    int warmup = 10;      // Trabajos previos por cliente (no se miden)
+    double rate = 0;      // Trabajos/s en total (0: cada cliente envía al recibir la respuesta)
+    double beta = 0;      // C = A * B + beta * C
+    uint64_t seed = 1;
+    int verifyRounds = 0;
+};
+
+// Latencias de un cliente
+struct ClientLatencies {
+    vector<double> totalMs, queueMs, serviceMs;
+    long long errors = 0;
+    string firstError;
+};
+
+// Borra los archivos compartidos del generador al salir
+struct SharedFiles {
+    vector<string> paths;
+    ~SharedFiles() {
+        for (const string& path : paths) ::unlink(path.c_str());
+    }
+};
+
+// Lanza los clientes contra el daemon y reporta la latencia de ida y vuelta
+// (desde el envío o, con --rate, desde el instante programado, para no
+// ocultar la espera acumulada) y la de cola y servicio informadas por el daemon
+template <typename T, typename Acc>
+int runLoad(const LoadOptions& o) {
+    int n = o.size;
+    SharedFiles files;
+    vector<MappedMatrix<T>> as(o.clients), bs(o.clients);
+    vector<MappedMatrix<Acc>> cs(o.clients);
+    vector<string> names;
+    for (int k = 0; k < o.clients; k++) {
+        string prefix = "matmul-" + to_string(getpid()) + "-" + to_string(k);
+        for (const char* m : {"-a.mat", "-b.mat", "-c.mat"}) {
+            names.push_back(prefix + m);
+            files.paths.push_back(workerSharedPath(names.back()));
+        }
+        as[k] = MappedMatrix<T>::create(files.paths[3 * k], n, n);
+        bs[k] = MappedMatrix<T>::create(files.paths[3 * k + 1], n, n);
+        cs[k] = MappedMatrix<Acc>::create(files.paths[3 * k + 2], n, n);
+        fillRandomMatrix<T>(as[k].view(), o.seed, 2 * k);
+        fillRandomMatrix<T>(bs[k].view(), o.seed, 2 * k + 1);
+    }
+    cout << o.clients << " clientes, " << o.jobs << " trabajos de " << n << "x" << n << " ("
+         << elementTypeName(o.type) << ") en /dev/shm\n";
+
+    // Ida y vuelta sin trabajo: el coste del socket y la cola
+    {
+        WorkerClient client(o.socketPath);
+        vector<double> pingMs;
+        for (int i = 0; i < 200; i++) {
+            auto start = chrono::steady_clock::now();
+            client.ping(i);
+            pingMs.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+        }
+        printLatencySummary(cout, "Ping (sin trabajo)", pingMs);
+    }
+
+    vector<ClientLatencies> results(o.clients);
+    vector<thread> threads;
+    auto wallStart = chrono::steady_clock::now();
+    for (int k = 0; k < o.clients; k++) {
+        threads.emplace_back([&, k] {
+            ClientLatencies& r = results[k];
+            try {
+                WorkerClient client(o.socketPath);
+                auto job = [&](uint64_t id) {
+                    return client.multiply(id, o.type, names[3 * k], names[3 * k + 1], names[3 * k + 2], 1.0, o.beta);
+                };
+                for (int i = 0; i < o.warmup; i++) job(i); // Proyecciones del daemon y caché
+                int count = o.jobs / o.clients + (k < o.jobs % o.clients);
+                chrono::duration<double> interval(o.rate > 0 ? o.clients / o.rate : 0.0);
+                auto first = chrono::steady_clock::now();
+                for (int i = 0; i < count; i++) {
+                    auto start = chrono::steady_clock::now();
+                    if (o.rate > 0) {
+                        auto scheduled = first + chrono::duration_cast<chrono::steady_clock::duration>(interval * i);
+                        this_thread::sleep_until(scheduled);
+                        start = scheduled;
+                    }
+                    WorkerResponse response = job((uint64_t)k << 32 | (uint64_t)i);
+                    r.totalMs.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+                    r.queueMs.push_back(response.queueNs / 1e6);
+                    r.serviceMs.push_back(response.serviceNs / 1e6);
+                    if (response.status != 0 && r.errors++ == 0) r.firstError = response.message;
+                }
+            } catch (const exception& e) {
+                r.errors++;
+                r.firstError = e.what();
+            }
+        });
+    }
+    for (thread& t : threads) t.join();
+    chrono::duration<double> wall = chrono::steady_clock::now() - wallStart;
+
+    ClientLatencies all;
+    for (ClientLatencies& r : results) {
+        all.totalMs.insert(all.totalMs.end(), r.totalMs.begin(), r.totalMs.end());
+        all.queueMs.insert(all.queueMs.end(), r.queueMs.begin(), r.queueMs.end());
+        all.serviceMs.insert(all.serviceMs.end(), r.serviceMs.begin(), r.serviceMs.end());
+        all.errors += r.errors;
+        if (all.firstError.empty()) all.firstError = r.firstError;
+    }
+
+    cout << "--- Latencia por trabajo ---\n";
+    printLatencySummary(cout, "Ida y vuelta", all.totalMs);
+    printLatencySummary(cout, "Espera en cola (daemon)", all.queueMs);
+    printLatencySummary(cout, "Servicio (daemon)", all.serviceMs);
+    double jobsPerSecond = all.totalMs.size() / wall.count();
+    cout << "Rendimiento: " << jobsPerSecond << " trabajos/s, " << 2.0 * n * n * (double)n * jobsPerSecond / 1e9
+         << " GOP/s (" << wall.count() << " s)\n";
+    if (all.errors > 0) {
+        cout << "Trabajos con error: " << all.errors << " (" << all.firstError << ")\n";
+        return 1;
+    }
+
+    if (o.verifyRounds > 0) {
+        if (o.beta != 0) {
+            cout << "Verificación omitida: con beta != 0, C acumula todos los trabajos\n";
+            return 0;
+        }
+        for (int k = 0; k < o.clients; k++) {
+            auto verifyStart = chrono::steady_clock::now();
+            VerifyReport check = freivaldsVerify<T, Acc>(as[k].view(), bs[k].view(), cs[k].view(), o.verifyRounds, o.seed);
+            chrono::duration<double, milli> verifyTime = chrono::steady_clock::now() - verifyStart;
+            cout << "Cliente " << k << ": ";
+            printVerifyReport(cout, check, verifyTime.count());
+            if (!check.ok) return 1;
+        }
+    }
+    return 0;
+}
+
+// Daemon activo, para detenerlo desde SIGINT/SIGTERM
+WorkerServer* activeServer = nullptr;
+
+void stopServer(int) {
+    if (activeServer != nullptr) activeServer->requestStop();
+}
+
+int main(int argc, char* argv[]) {
+    // Modos:   --serve        (daemon: atiende trabajos hasta --stop, Ctrl+C o SIGTERM)
+    //          --load         (generador de carga contra un daemon en marcha)
+    //          --stop         (pide al daemon que termine tras los trabajos encolados)
+    // Opciones: --socket P    (socket Unix; por defecto /tmp/matmul_worker.sock)
+    //           --threads N   (hilos del pool del daemon)
+    //           --type T      (int32, int32-acc64, int64, float, double; ver ElementType.hpp)
+    //           --size N      (daemon: lado del calentamiento, 0 sin él; carga: lado de las matrices)
+    //           --log         (daemon: una línea por trabajo)
+    //           --jobs J      (carga: trabajos medidos; por defecto 200)
+    //           --clients C   (carga: conexiones concurrentes; por defecto 1)
+    //           --warmup W    (carga: trabajos previos por cliente; por defecto 10)
+    //           --rate R      (carga: trabajos/s en total a ritmo fijo; por defecto, sin pausa)
+    //           --beta B      (carga: C = A * B + beta * C en cada trabajo)
+    //           --seed S      (carga: semilla de A y B; por defecto, aleatoria)
+    //           --verify [R]  (carga: comprueba C de cada cliente con Freivalds al final)
+    string mode;
+    WorkerServerOptions server;
+    LoadOptions load;
+    load.seed = random_device{}();
+    int size = -1;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--serve" || arg == "--load" || arg == "--stop") {
+            mode = arg;
+        } else if (arg == "--socket" && i + 1 < argc) {
+            server.socketPath = load.socketPath = argv[++i];
+        } else if (arg == "--threads" && i + 1 < argc) {
+            setDefaultThreadCount(atoi(argv[++i]));
+        } else if (arg == "--type" && i + 1 < argc) {
+            if (!parseElementType(argv[++i], load.type)) {
+                cout << "Tipo no válido: " << argv[i] << "\n";
+                return 1;
+            }
+            server.warmType = load.type;
+        } else if (arg == "--size" && i + 1 < argc) {
+            size = max(0, atoi(argv[++i]));
+        } else if (arg == "--log") {
+            server.logJobs = true;
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            load.jobs = max(1, atoi(argv[++i]));
+        } else if (arg == "--clients" && i + 1 < argc) {
+            load.clients = max(1, atoi(argv[++i]));
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            load.warmup = max(0, atoi(argv[++i]));
+        } else if (arg == "--rate" && i + 1 < argc) {
+            load.rate = atof(argv[++i]);
+        } else if (arg == "--beta" && i + 1 < argc) {
+            load.beta = atof(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            load.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--verify") {
+            // Número de rondas opcional
+            load.verifyRounds = (i + 1 < argc && isdigit((unsigned char)argv[i + 1][0])) ? atoi(argv[++i])
+                                                                                        : VERIFY_DEFAULT_ROUNDS;
+        }
+    }
+    if (size >= 0) server.warmSize = load.size = size;
+
+    try {
+        if (mode == "--serve") {
+            cout << "DAEMON DE MULTIPLICACIÓN DE MATRICES\n";
+            cout << "-----------------------------------------------------------\n";
+            WorkerServer daemon(server);
+            activeServer = &daemon;
+            signal(SIGINT, stopServer);
+            signal(SIGTERM, stopServer);
+            daemon.run(cout);
+            activeServer = nullptr;
+            return 0;
+        }
+        if (mode == "--load") {
+            cout << "GENERADOR DE CARGA PARA EL DAEMON DE MULTIPLICACIÓN\n";
+            cout << "-----------------------------------------------------------\n";
+            if (load.size <= 0) {
+                cout << "El tamaño de la matriz debe ser positivo.\n";
+                return 1;
+            }
+            return dispatchElementType(load.type, [&](auto t, auto acc) {
+                return runLoad<decltype(t), decltype(acc)>(load);
+            });
+        }
+        if (mode == "--stop") {
+            WorkerClient(load.socketPath).shutdown();
+            cout << "Daemon detenido.\n";
+            return 0;
+        }
+    } catch (const exception& e) {
+        cout << e.what() << "\n";
+        return 1;
+    }
+    cout << "Uso: worker_cpp --serve | --load | --stop [opciones]\n";
+    return 1;
+}
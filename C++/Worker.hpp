@@ -0,0 +1,514 @@
+#ifndef WORKER_HPP
+#define WORKER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ElementType.hpp"
+#include "Matrix.hpp"
+#include "MatrixFile.hpp"
+#include "RandomMatrix.hpp"
+#include "Strassen.hpp"
+#include "ThreadPool.hpp"
+
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Daemon de multiplicación: un proceso de larga duración que mantiene
+// caliente lo que una ejecución suelta paga en cada arranque (hilos del pool
+// creados, arena de multiply_into reservada y con sus páginas tocadas, tuning
+// leído, kernels SIMD elegidos) y atiende trabajos de otros procesos de la
+// misma máquina por un socket Unix (SOCK_STREAM).
+//
+// Las matrices no viajan por el socket: cada petición lleva la ruta de tres
+// archivos binarios de MatrixFile.hpp en memoria compartida (/dev/shm), que
+// cliente y daemon proyectan con MAP_SHARED. El daemon lee A y B y escribe
+// C = alpha * A * B + beta * C (multiply_into) sobre las mismas páginas que ve
+// el cliente: sin copias en ninguna dirección. Las proyecciones se conservan
+// entre trabajos (WorkerMappingCache), así que un cliente que reutiliza sus
+// buffers no provoca ni mmap ni fallos de página.
+//
+// Los trabajos de todas las conexiones pasan por una cola y los ejecuta de
+// uno en uno un único hilo, cada uno con todo el pool; la respuesta informa
+// el tiempo de espera en la cola y el de servicio.
+
+constexpr char WORKER_DEFAULT_SOCKET[] = "/tmp/matmul_worker.sock";
+constexpr std::uint32_t WORKER_MAGIC = 0x4D4D574Bu; // "KWMM"
+constexpr int WORKER_PATH_MAX = 256;                // Ruta de cada matriz, con el 0 final
+constexpr int WORKER_MESSAGE_MAX = 200;             // Mensaje de error de la respuesta
+constexpr size_t WORKER_MAPPING_CACHE_MAX = 64;     // Proyecciones conservadas por tipo
+
+enum class WorkerOp : std::uint32_t { Multiply = 1, Ping = 2, Shutdown = 3 };
+
+// Petición de tamaño fijo (misma máquina: se envía tal cual, sin serializar)
+struct WorkerRequest {
+    std::uint32_t magic;
+    std::uint32_t op;   // WorkerOp
+    std::uint32_t type; // ElementType de A y B; C es del tipo de acumulación
+    std::uint32_t reserved;
+    std::uint64_t id;   // Elegido por el cliente, vuelve en la respuesta
+    double alpha, beta;
+    char a[WORKER_PATH_MAX], b[WORKER_PATH_MAX], c[WORKER_PATH_MAX];
+};
+
+struct WorkerResponse {
+    std::uint32_t magic;
+    std::int32_t status;     // 0 si el trabajo terminó bien
+    std::uint64_t id;
+    std::uint64_t queueNs;   // Desde que se leyó la petición hasta empezar a ejecutarla
+    std::uint64_t serviceNs; // Proyección (si no estaba en caché) y multiplicación
+    char message[WORKER_MESSAGE_MAX];
+};
+
+// Ruta de una matriz compartida: un nombre sin '/' se busca en /dev/shm
+// (equivalente a shm_open en Linux); una ruta se usa tal cual
+inline std::string workerSharedPath(const std::string& name) {
+    return name.find('/') == std::string::npos ? "/dev/shm/" + name : name;
+}
+
+inline void workerCopyString(char* dst, size_t size, const std::string& src) {
+    size_t n = std::min(src.size(), size - 1);
+    std::memcpy(dst, src.data(), n);
+    dst[n] = '\0';
+}
+
+// Lee o escribe exactamente n bytes; false si la otra parte cerró o hubo error
+inline bool workerReadFull(int fd, void* data, size_t n) {
+    char* p = static_cast<char*>(data);
+    while (n > 0) {
+        ssize_t r = ::read(fd, p, n);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        p += r;
+        n -= (size_t)r;
+    }
+    return true;
+}
+
+inline bool workerWriteFull(int fd, const void* data, size_t n) {
+    const char* p = static_cast<const char*>(data);
+    while (n > 0) {
+        ssize_t r = ::send(fd, p, n, MSG_NOSIGNAL); // Sin SIGPIPE si el otro lado ya cerró
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        p += r;
+        n -= (size_t)r;
+    }
+    return true;
+}
+
+inline sockaddr_un workerSocketAddress(const std::string& path) {
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) throw std::runtime_error("Ruta de socket demasiado larga: " + path);
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return addr;
+}
+
+// Conecta al daemon; -1 si no hay nadie escuchando en path
+inline int workerConnect(const std::string& path) {
+    sockaddr_un addr = workerSocketAddress(path);
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Percentil por rango más cercano de valores ya ordenados (q en [0, 1])
+inline double latencyPercentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = (size_t)std::max(1.0, std::ceil(q * (double)sorted.size()));
+    return sorted[std::min(rank, sorted.size()) - 1];
+}
+
+// Una línea con p50, p90, p99, máximo y media de latencias en ms
+inline void printLatencySummary(std::ostream& out, const std::string& label, std::vector<double> ms) {
+    std::sort(ms.begin(), ms.end());
+    double sum = 0;
+    for (double t : ms) sum += t;
+    out << label << " (" << ms.size() << "): p50 " << latencyPercentile(ms, 0.50) << " ms, p90 "
+        << latencyPercentile(ms, 0.90) << " ms, p99 " << latencyPercentile(ms, 0.99) << " ms, máx "
+        << (ms.empty() ? 0.0 : ms.back()) << " ms, media " << (ms.empty() ? 0.0 : sum / (double)ms.size())
+        << " ms\n";
+}
+
+// --- Cliente ---
+
+// Conexión de un cliente: una petición en vuelo cada vez (call espera la respuesta)
+class WorkerClient {
+public:
+    explicit WorkerClient(const std::string& socketPath) : fd_(workerConnect(socketPath)) {
+        if (fd_ < 0) throw std::runtime_error("No hay un daemon escuchando en " + socketPath);
+    }
+
+    WorkerClient(const WorkerClient&) = delete;
+    WorkerClient& operator=(const WorkerClient&) = delete;
+
+    ~WorkerClient() { ::close(fd_); }
+
+    WorkerResponse call(WorkerRequest request) {
+        request.magic = WORKER_MAGIC;
+        WorkerResponse response;
+        if (!workerWriteFull(fd_, &request, sizeof(request)) || !workerReadFull(fd_, &response, sizeof(response)) ||
+            response.magic != WORKER_MAGIC) {
+            throw std::runtime_error("Se perdió la conexión con el daemon");
+        }
+        return response;
+    }
+
+    // C = alpha * A * B + beta * C con matrices compartidas (nombres de /dev/shm o rutas)
+    WorkerResponse multiply(std::uint64_t id, ElementType type, const std::string& a, const std::string& b,
+                            const std::string& c, double alpha = 1.0, double beta = 0.0) {
+        WorkerRequest request = {};
+        request.op = (std::uint32_t)WorkerOp::Multiply;
+        request.type = (std::uint32_t)type;
+        request.id = id;
+        request.alpha = alpha;
+        request.beta = beta;
+        workerCopyString(request.a, sizeof(request.a), workerSharedPath(a));
+        workerCopyString(request.b, sizeof(request.b), workerSharedPath(b));
+        workerCopyString(request.c, sizeof(request.c), workerSharedPath(c));
+        return call(request);
+    }
+
+    WorkerResponse ping(std::uint64_t id) {
+        WorkerRequest request = {};
+        request.op = (std::uint32_t)WorkerOp::Ping;
+        request.id = id;
+        return call(request);
+    }
+
+    // Pide al daemon que termine tras los trabajos ya encolados
+    WorkerResponse shutdown() {
+        WorkerRequest request = {};
+        request.op = (std::uint32_t)WorkerOp::Shutdown;
+        return call(request);
+    }
+
+private:
+    int fd_;
+};
+
+// --- Daemon ---
+
+// Proyecciones abiertas por ruta. Una entrada se reutiliza mientras el
+// archivo sea el mismo (dispositivo, inodo y tamaño) y su cabecera no haya
+// cambiado; si no, se vuelve a abrir. get devuelve un shared_ptr: lo que usa
+// un trabajo sigue proyectado hasta que termina aunque la entrada se
+// sustituya o se descarte. Lleno, se descarta la usada hace más tiempo. Solo
+// la usa el hilo que ejecuta.
+template <typename T>
+class WorkerMappingCache {
+public:
+    std::shared_ptr<MappedMatrix<T>> get(const std::string& path, bool writable) {
+        struct stat st;
+        if (::stat(path.c_str(), &st) != 0) throw std::runtime_error("No existe la matriz compartida " + path);
+        auto it = entries_.find(path);
+        if (it != entries_.end()) {
+            Entry& e = it->second;
+            if (e.dev == st.st_dev && e.ino == st.st_ino && e.size == st.st_size && (e.writable || !writable) &&
+                !e.matrix->headerChanged()) {
+                e.lastUse = ++uses_;
+                return e.matrix;
+            }
+            entries_.erase(it);
+        }
+        if (entries_.size() >= WORKER_MAPPING_CACHE_MAX) {
+            auto oldest = std::min_element(entries_.begin(), entries_.end(), [](const auto& x, const auto& y) {
+                return x.second.lastUse < y.second.lastUse;
+            });
+            entries_.erase(oldest);
+        }
+        Entry e{std::make_shared<MappedMatrix<T>>(MappedMatrix<T>::open(path, writable)), st.st_dev, st.st_ino,
+                st.st_size, writable, ++uses_};
+        return entries_.emplace(path, std::move(e)).first->second.matrix;
+    }
+
+private:
+    struct Entry {
+        std::shared_ptr<MappedMatrix<T>> matrix;
+        dev_t dev;
+        ino_t ino;
+        off_t size;
+        bool writable;
+        std::uint64_t lastUse; // Valor de uses_ en el último get
+    };
+    std::map<std::string, Entry> entries_;
+    std::uint64_t uses_ = 0;
+};
+
+// true si las dos rutas son el mismo archivo (mismo dispositivo e inodo)
+inline bool workerSameFile(const std::string& a, const std::string& b) {
+    struct stat sa, sb;
+    return ::stat(a.c_str(), &sa) == 0 && ::stat(b.c_str(), &sb) == 0 && sa.st_dev == sb.st_dev &&
+           sa.st_ino == sb.st_ino;
+}
+
+struct WorkerServerOptions {
+    std::string socketPath = WORKER_DEFAULT_SOCKET;
+    int warmSize = 512;                       // Calentamiento: multiplicaciones de este lado (0: ninguna)
+    ElementType warmType = ElementType::Int32;
+    bool logJobs = false;                     // Una línea por trabajo
+};
+
+class WorkerServer {
+public:
+    explicit WorkerServer(WorkerServerOptions options) : options_(std::move(options)) {}
+
+    WorkerServer(const WorkerServer&) = delete;
+    WorkerServer& operator=(const WorkerServer&) = delete;
+
+    // Escucha en el socket y atiende hasta recibir Shutdown o requestStop().
+    // Lanza runtime_error si el socket está en uso o no se puede crear.
+    void run(std::ostream& log) {
+        listen();
+        log_ = &log;
+        std::thread executor([this] { executorLoop(); });
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            readyCv_.wait(lock, [this] { return ready_; }); // Calentamiento terminado
+        }
+        log << "Daemon escuchando en " << options_.socketPath << " (" << defaultThreadPool().size() << " hilos, kernel "
+            << simdIsaName(simdKernels().isa) << ")\n" << std::flush;
+
+        while (true) {
+            int fd = ::accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR && !stopping_.load()) continue;
+                break; // requestStop() cerró el socket de escucha
+            }
+            reapConnections();
+            auto connection = std::make_shared<Connection>(fd);
+            connection->reader = std::thread([this, connection] { readerLoop(connection); });
+            connections_.push_back(connection);
+        }
+
+        // Despierta a los lectores bloqueados y espera a que se vacíe la cola
+        for (auto& connection : connections_) ::shutdown(connection->fd, SHUT_RDWR);
+        for (auto& connection : connections_) connection->reader.join();
+        connections_.clear();
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            executorStop_ = true;
+        }
+        queueCv_.notify_one();
+        executor.join();
+        ::close(listenFd_);
+        ::unlink(options_.socketPath.c_str());
+        printSummary(log);
+    }
+
+    // Termina run() (se puede llamar desde un manejador de señales)
+    void requestStop() {
+        stopping_.store(true);
+        ::shutdown(listenFd_, SHUT_RDWR);
+    }
+
+private:
+    struct Connection {
+        explicit Connection(int fd) : fd(fd) {}
+        ~Connection() { ::close(fd); }
+        int fd;
+        std::thread reader;
+        std::mutex writeMutex;
+        std::atomic<bool> finished{false};
+    };
+
+    struct Job {
+        WorkerRequest request;
+        std::shared_ptr<Connection> connection;
+        std::chrono::steady_clock::time_point received;
+    };
+
+    void listen() {
+        sockaddr_un addr = workerSocketAddress(options_.socketPath);
+        int probe = workerConnect(options_.socketPath);
+        if (probe >= 0) {
+            ::close(probe);
+            throw std::runtime_error("Ya hay un daemon escuchando en " + options_.socketPath);
+        }
+        ::unlink(options_.socketPath.c_str()); // Socket de un daemon anterior que no terminó bien
+        listenFd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (listenFd_ < 0 || ::bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            ::listen(listenFd_, 64) != 0) {
+            throw std::runtime_error("No se pudo escuchar en " + options_.socketPath);
+        }
+    }
+
+    // Junta los lectores de conexiones ya cerradas
+    void reapConnections() {
+        auto done = std::remove_if(connections_.begin(), connections_.end(), [](const std::shared_ptr<Connection>& c) {
+            if (!c->finished.load()) return false;
+            c->reader.join();
+            return true;
+        });
+        connections_.erase(done, connections_.end());
+    }
+
+    void readerLoop(std::shared_ptr<Connection> connection) {
+        WorkerRequest request;
+        while (workerReadFull(connection->fd, &request, sizeof(request))) {
+            if (request.magic != WORKER_MAGIC) break; // Protocolo desconocido: se cierra la conexión
+            request.a[WORKER_PATH_MAX - 1] = request.b[WORKER_PATH_MAX - 1] = request.c[WORKER_PATH_MAX - 1] = '\0';
+            {
+                std::lock_guard<std::mutex> lock(queueMutex_);
+                queue_.push_back(Job{request, connection, std::chrono::steady_clock::now()});
+            }
+            queueCv_.notify_one();
+        }
+        connection->finished.store(true);
+    }
+
+    void executorLoop() {
+        warmUp();
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            ready_ = true;
+        }
+        readyCv_.notify_all();
+
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(queueMutex_);
+                queueCv_.wait(lock, [this] { return executorStop_ || !queue_.empty(); });
+                if (queue_.empty()) return;
+                job = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            auto start = std::chrono::steady_clock::now();
+            WorkerResponse response = {};
+            response.magic = WORKER_MAGIC;
+            response.id = job.request.id;
+            try {
+                execute(job.request);
+            } catch (const std::exception& e) {
+                response.status = 1;
+                workerCopyString(response.message, sizeof(response.message), e.what());
+            }
+            auto end = std::chrono::steady_clock::now();
+            response.queueNs = (std::uint64_t)std::chrono::nanoseconds(start - job.received).count();
+            response.serviceNs = (std::uint64_t)std::chrono::nanoseconds(end - start).count();
+            {
+                std::lock_guard<std::mutex> lock(job.connection->writeMutex);
+                workerWriteFull(job.connection->fd, &response, sizeof(response));
+            }
+            record(job.request, response);
+            if (job.request.op == (std::uint32_t)WorkerOp::Shutdown) requestStop();
+        }
+    }
+
+    // Deja listo lo que cuesta en la primera multiplicación: hilos del pool,
+    // tuning, kernels, buffers de empaquetado y la arena de multiply_into del
+    // hilo ejecutor, reservada para warmSize y con todas sus páginas tocadas
+    void warmUp() {
+        if (options_.warmSize <= 0) return;
+        int n = options_.warmSize;
+        dispatchElementType(options_.warmType, [&](auto t, auto acc) {
+            using T = decltype(t);
+            using Acc = decltype(acc);
+            Matrix<T> A(n, n), B(n, n);
+            Matrix<Acc> C(n, n);
+            fillRandomMatrix<T>(A.view(), 1, 0);
+            fillRandomMatrix<T>(B.view(), 1, 1);
+            multiplyIntoWorkspace(multiply_into_workspace_size<T, Acc>(n, n, n)).prefault();
+            for (int round = 0; round < 2; round++) multiply_into<T, Acc>(C.view(), A.view(), B.view());
+        });
+    }
+
+    void execute(const WorkerRequest& request) {
+        switch ((WorkerOp)request.op) {
+            case WorkerOp::Ping:
+            case WorkerOp::Shutdown: return;
+            case WorkerOp::Multiply: break;
+            default: throw std::runtime_error("Operación desconocida");
+        }
+        if (request.type > (std::uint32_t)ElementType::Double) throw std::runtime_error("Tipo de elemento desconocido");
+        dispatchElementType((ElementType)request.type, [&](auto t, auto acc) {
+            using T = decltype(t);
+            using Acc = decltype(acc);
+            // multiply_into exige que C no se solape con A ni con B
+            if (workerSameFile(request.c, request.a) || workerSameFile(request.c, request.b)) {
+                throw std::runtime_error("C no puede ser el mismo archivo que A o B");
+            }
+            // Los shared_ptr mantienen las proyecciones hasta el final del trabajo
+            std::shared_ptr<MappedMatrix<T>> fileA = mappings<T>().get(request.a, false);
+            std::shared_ptr<MappedMatrix<T>> fileB = mappings<T>().get(request.b, false);
+            std::shared_ptr<MappedMatrix<Acc>> fileC = mappings<Acc>().get(request.c, true);
+            MatrixView<const T> A = fileA->view();
+            MatrixView<const T> B = fileB->view();
+            MatrixView<Acc> C = fileC->view();
+            if (A.cols() != B.rows() || C.rows() != A.rows() || C.cols() != B.cols()) {
+                throw std::runtime_error("Dimensiones incompatibles: A " + std::to_string(A.rows()) + "x" +
+                                         std::to_string(A.cols()) + ", B " + std::to_string(B.rows()) + "x" +
+                                         std::to_string(B.cols()) + ", C " + std::to_string(C.rows()) + "x" +
+                                         std::to_string(C.cols()));
+            }
+            multiply_into<T, Acc>(C, A, B, Acc(request.alpha), Acc(request.beta));
+        });
+    }
+
+    template <typename T>
+    WorkerMappingCache<T>& mappings() {
+        static WorkerMappingCache<T> cache; // Solo desde el hilo ejecutor
+        return cache;
+    }
+
+    void record(const WorkerRequest& request, const WorkerResponse& response) {
+        if (request.op != (std::uint32_t)WorkerOp::Multiply) return;
+        double queueMs = response.queueNs / 1e6, serviceMs = response.serviceNs / 1e6;
+        if (response.status != 0) failed_++;
+        queueMs_.push_back(queueMs);
+        serviceMs_.push_back(serviceMs);
+        if (options_.logJobs || response.status != 0) {
+            *log_ << "Trabajo " << request.id << ": cola " << queueMs << " ms, servicio " << serviceMs << " ms"
+                  << (response.status != 0 ? std::string(", error: ") + response.message : std::string()) << "\n"
+                  << std::flush;
+        }
+    }
+
+    void printSummary(std::ostream& out) {
+        out << "Daemon detenido: " << serviceMs_.size() << " trabajos (" << failed_ << " con error)\n";
+        if (serviceMs_.empty()) return;
+        printLatencySummary(out, "Espera en cola", queueMs_);
+        printLatencySummary(out, "Servicio", serviceMs_);
+    }
+
+    WorkerServerOptions options_;
+    int listenFd_ = -1;
+    std::atomic<bool> stopping_{false};
+    std::vector<std::shared_ptr<Connection>> connections_;
+
+    std::mutex queueMutex_;
+    std::condition_variable queueCv_, readyCv_;
+    std::deque<Job> queue_;
+    bool executorStop_ = false;
+    bool ready_ = false;
+
+    // Solo el hilo ejecutor
+    std::ostream* log_ = nullptr;
+    std::vector<double> queueMs_, serviceMs_;
+    long long failed_ = 0;
+};
+
+#endif
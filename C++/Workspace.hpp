@@ -0,0 +1,97 @@
+#ifndef WORKSPACE_HPP
+#define WORKSPACE_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "Matrix.hpp"
+
+// Arena de trabajo para temporales: se reserva una vez y se reparte como una
+// pila (bump allocator). Las reservas se liberan en orden inverso restaurando
+// una marca, de modo que la recursión no toca el heap tras la creación.
+class Workspace {
+public:
+    Workspace() = default;
+
+    explicit Workspace(size_t bytes) : capacity_(alignUp(bytes)) {
+        if (capacity_ == 0) return;
+        base_ = static_cast<unsigned char*>(alignedAllocate(MATRIX_ALIGNMENT, capacity_));
+        owned_ = true;
+    }
+
+    // Arena sobre memoria ajena (p. ej. una región reservada de otra arena)
+    Workspace(void* base, size_t bytes) : base_(static_cast<unsigned char*>(base)), capacity_(bytes) {}
+
+    Workspace(const Workspace&) = delete;
+    Workspace& operator=(const Workspace&) = delete;
+
+    ~Workspace() {
+        if (owned_) alignedFree(base_, capacity_);
+    }
+
+    // Bytes que ocupa en la arena una matriz rows x cols (stride alineado)
+    template <typename T>
+    static size_t matrixBytes(int rows, int cols) {
+        return alignUp((size_t)rows * Matrix<T>::paddedStride(cols) * sizeof(T));
+    }
+
+    // Reserva bytes (alineados a 64) sin inicializar; lanza bad_alloc si no caben
+    void* allocateBytes(size_t bytes) {
+        bytes = alignUp(bytes);
+        if (bytes > capacity_ - used_) throw std::bad_alloc();
+        void* ptr = base_ + used_;
+        used_ += bytes;
+        if (used_ > peak_) peak_ = used_;
+        return ptr;
+    }
+
+    // Reserva una matriz sin inicializar
+    template <typename T>
+    MatrixView<T> allocateMatrix(int rows, int cols) {
+        T* data = static_cast<T*>(allocateBytes(matrixBytes<T>(rows, cols)));
+        return MatrixView<T>(data, rows, cols, Matrix<T>::paddedStride(cols));
+    }
+
+    size_t mark() const { return used_; }
+    void release(size_t mark) { used_ = mark; }
+
+    size_t capacity() const { return capacity_; }
+
+    // Toca una vez cada página de la arena para que el sistema la asigne ya:
+    // la primera multiplicación no paga los fallos de página (p. ej. un
+    // proceso de larga duración que se calienta al arrancar)
+    void prefault() {
+        for (size_t offset = 0; offset < capacity_; offset += 4096) base_[offset] = 0;
+    }
+
+    size_t used() const { return used_; }
+    size_t peak() const { return peak_; }
+
+    static size_t alignUp(size_t bytes) {
+        return (bytes + MATRIX_ALIGNMENT - 1) / MATRIX_ALIGNMENT * MATRIX_ALIGNMENT;
+    }
+
+private:
+    unsigned char* base_ = nullptr;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+    size_t peak_ = 0;
+    bool owned_ = false;
+};
+
+// Libera al salir del ámbito todo lo reservado dentro de él
+class WorkspaceScope {
+public:
+    explicit WorkspaceScope(Workspace& ws) : ws_(ws), mark_(ws.mark()) {}
+    ~WorkspaceScope() { ws_.release(mark_); }
+
+    WorkspaceScope(const WorkspaceScope&) = delete;
+    WorkspaceScope& operator=(const WorkspaceScope&) = delete;
+
+private:
+    Workspace& ws_;
+    size_t mark_;
+};
+
+#endif
@@ -1,6 +1,12 @@
 #include <stdio.h>
 #include <stdlib.h> // Para malloc, free, rand, srand
-#include <time.h>   // Para clock, time
+#include <string.h> // Para strcmp
+#include <time.h>   // Para clock, time, clock_gettime
+#ifdef _OPENMP
+#include <omp.h>    // Paralelismo opcional (compilar con -fopenmp)
+#endif
+
+#define NAIVE_TILE 64 // Lado de los tiles de salida que se reparten entre hilos
 
 // Función para asignar memoria para una matriz cuadrada
 int **allocateMatrix(int size) {
@@ -72,7 +78,11 @@ void printMatrix(int size, int **matrix, const char *name) {
     printf("\n");
 }
 
-// Algoritmo Clásico (Naive) para multiplicar dos matrices cuadradas
+// Algoritmo Clásico (Naive) para multiplicar dos matrices cuadradas.
+// C se divide en tiles de NAIVE_TILE x NAIVE_TILE que se reparten entre hilos
+// (OpenMP, reparto estático: cada hilo recibe tiles contiguos por filas).
+// Dentro de cada tile se recorre k por bloques y se usa el orden i-k-j, que
+// lee B por filas en lugar de por columnas.
 int **naive_multiply(int size, int **matrixA, int **matrixB) {
     if (size == 0) return allocateMatrix(0);
     if (matrixA == NULL || matrixB == NULL || size < 0) return NULL;
@@ -83,23 +93,93 @@ int **naive_multiply(int size, int **matrixA, int **matrixB) {
         return NULL;
     }
 
-    for (int i = 0; i < size; i++) {
-        if (matrixA[i] == NULL || matrixC[i] == NULL) return NULL; // Chequeo adicional
-        for (int j = 0; j < size; j++) {
-            matrixC[i][j] = 0;
-            for (int k = 0; k < size; k++) {
-                if (matrixB[k] == NULL) return NULL; // Chequeo adicional
-                matrixC[i][j] += matrixA[i][k] * matrixB[k][j];
+    int tiles = (size + NAIVE_TILE - 1) / NAIVE_TILE;
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int ti = 0; ti < tiles; ti++) {
+        for (int tj = 0; tj < tiles; tj++) {
+            int iMin = ti * NAIVE_TILE, iMax = iMin + NAIVE_TILE < size ? iMin + NAIVE_TILE : size;
+            int jMin = tj * NAIVE_TILE, jMax = jMin + NAIVE_TILE < size ? jMin + NAIVE_TILE : size;
+            for (int i = iMin; i < iMax; i++) {
+                for (int j = jMin; j < jMax; j++) matrixC[i][j] = 0;
+            }
+            for (int kk = 0; kk < size; kk += NAIVE_TILE) {
+                int kMax = kk + NAIVE_TILE < size ? kk + NAIVE_TILE : size;
+                for (int i = iMin; i < iMax; i++) {
+                    int *rowC = matrixC[i];
+                    for (int k = kk; k < kMax; k++) {
+                        int aik = matrixA[i][k];
+                        int *rowB = matrixB[k];
+                        for (int j = jMin; j < jMax; j++) {
+                            rowC[j] += aik * rowB[j];
+                        }
+                    }
+                }
             }
         }
     }
     return matrixC;
 }
 
-int main() {
+// Tiempo de pared en segundos (clock() suma la CPU de todos los hilos)
+double wallTime(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int threadCount(void) {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+// Reporte de escalabilidad: repite la multiplicación con 1, 2, 4, ... hasta
+// maxThreads hilos e imprime tiempo de pared, aceleración y eficiencia.
+void printScalingReport(int size, int **matrixA, int **matrixB, int maxThreads) {
+#ifdef _OPENMP
+    printf("--- Escalabilidad (naive por tiles, N = %d) ---\n", size);
+    printf("Hilos\tTiempo (s)\tAceleración\tEficiencia\n");
+    double baseTime = 0.0;
+    for (int threads = 1;; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+        omp_set_num_threads(threads);
+        double start = wallTime();
+        int **matrixC = naive_multiply(size, matrixA, matrixB);
+        double elapsed = wallTime() - start;
+        freeMatrix(size, matrixC);
+        if (threads == 1) baseTime = elapsed;
+        double speedup = baseTime / elapsed;
+        printf("%d\t%.6f\t%.2fx\t\t%.1f%%\n", threads, elapsed, speedup, speedup / threads * 100.0);
+        if (threads == maxThreads) break;
+    }
+    omp_set_num_threads(maxThreads);
+    printf("\n");
+#else
+    (void)size; (void)matrixA; (void)matrixB; (void)maxThreads;
+    printf("Reporte de escalabilidad no disponible: compilar con -fopenmp.\n");
+#endif
+}
+
+int main(int argc, char *argv[]) {
     int size;
     clock_t startTime, endTime;
-    double cpu_time_used;
+    double cpu_time_used, wall_time_used;
+    int scaling = 0;
+
+    // Opciones: --threads N (requiere -fopenmp) y --scaling (reporte de 1 a N hilos)
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            int threads = atoi(argv[++i]);
+#ifdef _OPENMP
+            if (threads > 0) omp_set_num_threads(threads);
+#else
+            (void)threads;
+#endif
+        } else if (strcmp(argv[i], "--scaling") == 0) {
+            scaling = 1;
+        }
+    }
     unsigned long long memory_used_bytes = 0;
 
     // Sembrar el generador de números aleatorios una vez
@@ -147,9 +227,11 @@ int main() {
         printf("Matrices A y B generadas (%dx%d). No se imprimirán debido a su tamaño.\n\n", size, size);
     }
 
+    double wallStart = wallTime();
     startTime = clock();
     int **matrixC = naive_multiply(size, matrixA, matrixB);
     endTime = clock();
+    wall_time_used = wallTime() - wallStart;
 
     if (matrixC == NULL && size > 0) { // Solo es error si size > 0 y C es NULL
         printf("La multiplicación de matrices (ingenua) falló.\n");
@@ -176,12 +258,19 @@ int main() {
     }
 
     printf("--- Métricas de Rendimiento (Algoritmo Ingenuo) ---\n");
+    printf("Hilos: %d\n", threadCount());
     printf("Tiempo de CPU para la multiplicación: %.6f segundos\n", cpu_time_used);
+    printf("Tiempo de pared para la multiplicación: %.6f segundos\n", wall_time_used);
     printf("Memoria estimada utilizada por las matrices A, B y C: %llu bytes (%.2f KB / %.2f MB)\n",
            memory_used_bytes,
            (double)memory_used_bytes / 1024.0,
            (double)memory_used_bytes / (1024.0 * 1024.0));
 
+    if (scaling) {
+        printf("\n");
+        printScalingReport(size, matrixA, matrixB, threadCount());
+    }
+
     freeMatrix(size, matrixA);
     freeMatrix(size, matrixB);
     freeMatrix(size, matrixC); // Seguro incluso si size es 0 y matrixC es de allocateMatrix(0)
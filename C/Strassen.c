@@ -1,7 +1,12 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
-#define STRASSEN_THRESHOLD 64 // Umbral para cambiar a algoritmo ingenuo
+#define STRASSEN_THRESHOLD 64 // Umbral por defecto para cambiar a algoritmo ingenuo
+
+// Umbral en uso. Al arrancar se toma de la variable de entorno STRASSEN_THRESHOLD
+// o de la clave strassen_threshold_c del archivo de tuning (ver loadTuning).
+int strassen_threshold = STRASSEN_THRESHOLD;
 
 // --- Funciones Auxiliares (Comunes) ---
 int **allocateMatrix(int size) {
@@ -60,6 +65,62 @@ void printMatrix(int size, int **matrix, const char *name) {
     printf("\n");
 }
 
+// --- Arena de trabajo para los temporales de Strassen ---
+// Se reserva una sola vez y se reparte como una pila: cada nivel guarda la
+// marca 'used' y la restaura al terminar, sin malloc/free en la recursión.
+#define WORKSPACE_ALIGNMENT 64
+
+typedef struct {
+    unsigned char *base;
+    size_t capacity;
+    size_t used;
+} Workspace;
+
+size_t alignUp(size_t bytes) {
+    return (bytes + WORKSPACE_ALIGNMENT - 1) / WORKSPACE_ALIGNMENT * WORKSPACE_ALIGNMENT;
+}
+
+// Bytes que ocupa en la arena una matriz NxN (punteros de fila + datos contiguos)
+size_t workspaceMatrixBytes(int size) {
+    return alignUp((size_t)size * sizeof(int *)) + alignUp((size_t)size * (size_t)size * sizeof(int));
+}
+
+int workspaceInit(Workspace *ws, size_t bytes) {
+    ws->capacity = alignUp(bytes);
+    ws->used = 0;
+    ws->base = NULL;
+    if (ws->capacity == 0) return 0;
+    ws->base = (unsigned char *)aligned_alloc(WORKSPACE_ALIGNMENT, ws->capacity);
+    if (ws->base == NULL) {
+        perror("workspaceInit: Error reservando la arena");
+        return -1;
+    }
+    return 0;
+}
+
+void workspaceFree(Workspace *ws) {
+    free(ws->base);
+    ws->base = NULL;
+    ws->capacity = ws->used = 0;
+}
+
+// Reserva una matriz NxN (sin inicializar) de la arena; NULL si no cabe
+int **workspaceMatrix(Workspace *ws, int size) {
+    size_t bytes = workspaceMatrixBytes(size);
+    if (bytes > ws->capacity - ws->used) {
+        fprintf(stderr, "workspaceMatrix: Arena insuficiente (%zu bytes libres, %zu pedidos).\n",
+                ws->capacity - ws->used, bytes);
+        return NULL;
+    }
+    int **matrix = (int **)(ws->base + ws->used);
+    int *data = (int *)(ws->base + ws->used + alignUp((size_t)size * sizeof(int *)));
+    for (int i = 0; i < size; i++) {
+        matrix[i] = data + (size_t)i * size;
+    }
+    ws->used += bytes;
+    return matrix;
+}
+
 // --- Funciones Específicas de Strassen ---
 
 void addMatrices(int size, int **A, int **B, int **C) {
@@ -78,10 +139,7 @@ void subtractMatrices(int size, int **A, int **B, int **C) {
     }
 }
 
-int **naive_multiply_strassen_base(int size, int **A, int **B) {
-    if (size == 0) return allocateMatrix(0);
-    int **C = allocateMatrix(size);
-    if (!C) return NULL;
+void naive_multiply_strassen_base(int size, int **A, int **B, int **C) {
     for (int i = 0; i < size; i++) {
         for (int j = 0; j < size; j++) {
             C[i][j] = 0;
@@ -90,39 +148,35 @@ int **naive_multiply_strassen_base(int size, int **A, int **B) {
             }
         }
     }
-    return C;
 }
 
-int **strassen_recursive(int size, int **A, int **B); // Declaración adelantada
+#define STRASSEN_TEMPS_PER_LEVEL 17 // 8 submatrices + tempA/tempB + P1..P7
 
-int **strassen_multiply_internal(int size, int **A, int **B) {
-    if (size <= STRASSEN_THRESHOLD) {
-        return naive_multiply_strassen_base(size, A, B);
+// Calcula C = A * B. Todos los temporales salen de la arena ws.
+// Devuelve 0 si tuvo éxito o -1 si la arena no alcanza.
+int strassen_multiply_internal(int size, int **A, int **B, int **C, Workspace *ws) {
+    if (size <= strassen_threshold) {
+        naive_multiply_strassen_base(size, A, B, C);
+        return 0;
     }
 
     int newSize = size / 2;
-    // No es necesario crear C aquí, se crea al final a partir de los cuadrantes.
-
-    int **A11 = allocateMatrix(newSize); int **A12 = allocateMatrix(newSize);
-    int **A21 = allocateMatrix(newSize); int **A22 = allocateMatrix(newSize);
-    int **B11 = allocateMatrix(newSize); int **B12 = allocateMatrix(newSize);
-    int **B21 = allocateMatrix(newSize); int **B22 = allocateMatrix(newSize);
+    size_t mark = ws->used;
 
-    int **P1, **P2, **P3, **P4, **P5, **P6, **P7;
-    int **tempA = allocateMatrix(newSize);
-    int **tempB = allocateMatrix(newSize);
-
-    // Lista de todas las matrices temporales para facilitar la liberación en caso de error
-    int **all_temps[] = {A11, A12, A21, A22, B11, B12, B21, B22, tempA, tempB};
-    int num_all_temps = sizeof(all_temps) / sizeof(all_temps[0]);
-
-    for(int i=0; i < num_all_temps; ++i) {
-        if (all_temps[i] == NULL) {
+    int **temps[STRASSEN_TEMPS_PER_LEVEL];
+    for (int i = 0; i < STRASSEN_TEMPS_PER_LEVEL; ++i) {
+        temps[i] = workspaceMatrix(ws, newSize);
+        if (temps[i] == NULL) {
             fprintf(stderr, "Error asignando submatrices/temporales en Strassen.\n");
-            for(int j=0; j < num_all_temps; ++j) freeMatrix(newSize, all_temps[j]); // Liberar lo que se pudo
-            return NULL;
+            ws->used = mark;
+            return -1;
         }
     }
+    int **A11 = temps[0], **A12 = temps[1], **A21 = temps[2], **A22 = temps[3];
+    int **B11 = temps[4], **B12 = temps[5], **B21 = temps[6], **B22 = temps[7];
+    int **tempA = temps[8], **tempB = temps[9];
+    int **P1 = temps[10], **P2 = temps[11], **P3 = temps[12], **P4 = temps[13];
+    int **P5 = temps[14], **P6 = temps[15], **P7 = temps[16];
 
     for (int i = 0; i < newSize; i++) {
         for (int j = 0; j < newSize; j++) {
@@ -133,161 +187,264 @@ int **strassen_multiply_internal(int size, int **A, int **B) {
         }
     }
 
+    int status = 0;
     addMatrices(newSize, A11, A22, tempA); addMatrices(newSize, B11, B22, tempB);
-    P1 = strassen_multiply_internal(newSize, tempA, tempB);
+    status |= strassen_multiply_internal(newSize, tempA, tempB, P1, ws);
     addMatrices(newSize, A21, A22, tempA);
-    P2 = strassen_multiply_internal(newSize, tempA, B11);
+    status |= strassen_multiply_internal(newSize, tempA, B11, P2, ws);
     subtractMatrices(newSize, B12, B22, tempB);
-    P3 = strassen_multiply_internal(newSize, A11, tempB);
+    status |= strassen_multiply_internal(newSize, A11, tempB, P3, ws);
     subtractMatrices(newSize, B21, B11, tempB);
-    P4 = strassen_multiply_internal(newSize, A22, tempB);
+    status |= strassen_multiply_internal(newSize, A22, tempB, P4, ws);
     addMatrices(newSize, A11, A12, tempA);
-    P5 = strassen_multiply_internal(newSize, tempA, B22);
+    status |= strassen_multiply_internal(newSize, tempA, B22, P5, ws);
     subtractMatrices(newSize, A21, A11, tempA); addMatrices(newSize, B11, B12, tempB);
-    P6 = strassen_multiply_internal(newSize, tempA, tempB);
+    status |= strassen_multiply_internal(newSize, tempA, tempB, P6, ws);
     subtractMatrices(newSize, A12, A22, tempA); addMatrices(newSize, B21, B22, tempB);
-    P7 = strassen_multiply_internal(newSize, tempA, tempB);
-
-    int **all_Ps[] = {P1, P2, P3, P4, P5, P6, P7};
-    int num_all_Ps = sizeof(all_Ps) / sizeof(all_Ps[0]);
-    for(int i=0; i < num_all_Ps; ++i) {
-        if (all_Ps[i] == NULL) {
-            fprintf(stderr, "Error en una llamada recursiva de Strassen (P%d es NULL).\n", i+1);
-            for(int j=0; j < num_all_temps; ++j) freeMatrix(newSize, all_temps[j]);
-            for(int k=0; k < num_all_Ps; ++k) freeMatrix(newSize, all_Ps[k]); // Liberar los P que se crearon
-            return NULL;
-        }
-    }
-    
-    int **C11 = allocateMatrix(newSize); int **C12 = allocateMatrix(newSize);
-    int **C21 = allocateMatrix(newSize); int **C22 = allocateMatrix(newSize);
-    int **all_Cs_sub[] = {C11, C12, C21, C22};
-    int num_all_Cs_sub = sizeof(all_Cs_sub) / sizeof(all_Cs_sub[0]);
-
-    for(int i=0; i < num_all_Cs_sub; ++i) {
-        if (all_Cs_sub[i] == NULL) {
-            fprintf(stderr, "Error asignando submatrices de C en Strassen.\n");
-            for(int j=0; j < num_all_temps; ++j) freeMatrix(newSize, all_temps[j]);
-            for(int k=0; k < num_all_Ps; ++k) freeMatrix(newSize, all_Ps[k]);
-            for(int l=0; l < num_all_Cs_sub; ++l) freeMatrix(newSize, all_Cs_sub[l]);
-            return NULL;
-        }
-    }
+    status |= strassen_multiply_internal(newSize, tempA, tempB, P7, ws);
 
-    // C11 = P1 + P4 - P5 + P7
-    addMatrices(newSize, P1, P4, tempA);         // tempA = P1+P4
-    subtractMatrices(newSize, tempA, P5, tempB); // tempB = P1+P4-P5
-    addMatrices(newSize, tempB, P7, C11);        // C11 = P1+P4-P5+P7
-    // C12 = P3 + P5
-    addMatrices(newSize, P3, P5, C12);
-    // C21 = P2 + P4
-    addMatrices(newSize, P2, P4, C21);
-    // C22 = P1 - P2 + P3 + P6
-    subtractMatrices(newSize, P1, P2, tempA);    // tempA = P1-P2
-    addMatrices(newSize, tempA, P3, tempB);      // tempB = P1-P2+P3
-    addMatrices(newSize, tempB, P6, C22);        // C22 = P1-P2+P3+P6
-
-    int **C_final = allocateMatrix(size);
-    if (C_final == NULL) {
-         fprintf(stderr, "Error asignando matriz C_final en Strassen.\n");
-         // Liberar todo lo anterior
-            for(int j=0; j < num_all_temps; ++j) freeMatrix(newSize, all_temps[j]);
-            for(int k=0; k < num_all_Ps; ++k) freeMatrix(newSize, all_Ps[k]);
-            for(int l=0; l < num_all_Cs_sub; ++l) freeMatrix(newSize, all_Cs_sub[l]);
-         return NULL;
+    if (status != 0) {
+        fprintf(stderr, "Error en una llamada recursiva de Strassen.\n");
+        ws->used = mark;
+        return -1;
     }
 
+    // Los cuadrantes de C se escriben directamente desde P1..P7
     for (int i = 0; i < newSize; i++) {
         for (int j = 0; j < newSize; j++) {
-            C_final[i][j] = C11[i][j];
-            C_final[i][j + newSize] = C12[i][j];
-            C_final[i + newSize][j] = C21[i][j];
-            C_final[i + newSize][j + newSize] = C22[i][j];
+            C[i][j] = P1[i][j] + P4[i][j] - P5[i][j] + P7[i][j];           // C11
+            C[i][j + newSize] = P3[i][j] + P5[i][j];                        // C12
+            C[i + newSize][j] = P2[i][j] + P4[i][j];                        // C21
+            C[i + newSize][j + newSize] = P1[i][j] - P2[i][j] + P3[i][j] + P6[i][j]; // C22
         }
     }
 
-    for(int j=0; j < num_all_temps; ++j) freeMatrix(newSize, all_temps[j]);
-    for(int k=0; k < num_all_Ps; ++k) freeMatrix(newSize, all_Ps[k]);
-    for(int l=0; l < num_all_Cs_sub; ++l) freeMatrix(newSize, all_Cs_sub[l]);
-    
-    return C_final;
+    ws->used = mark;
+    return 0;
 }
 
-int **strassen_multiply(int original_size, int **A_orig, int **B_orig) {
-    if (original_size == 0) return allocateMatrix(0);
-    if (A_orig == NULL || B_orig == NULL || original_size < 0) return NULL;
-
-    int n = original_size;
+int nextPowerOfTwo(int n) {
     int new_size = 1;
-    while(new_size < n) {
+    while (new_size < n) {
         new_size *= 2; // Siguiente potencia de 2
     }
+    return new_size;
+}
 
-    int **A_padded = A_orig;
-    int **B_padded = B_orig;
+// Bytes de arena que necesita strassen_multiply_ws para una matriz NxN:
+// padding (si N no es potencia de 2) + temporales de cada nivel de recursión.
+// Permite reservar una arena una vez y reutilizarla en muchas multiplicaciones.
+size_t strassen_workspace_size(int size) {
+    if (size <= 0) return 0;
+    int new_size = nextPowerOfTwo(size);
+    size_t bytes = 0;
+    if (new_size != size) {
+        bytes += 3 * workspaceMatrixBytes(new_size); // A, B y C con padding
+    }
+    for (int n = new_size; n > strassen_threshold; n /= 2) {
+        bytes += STRASSEN_TEMPS_PER_LEVEL * workspaceMatrixBytes(n / 2);
+    }
+    return bytes;
+}
 
-    if (new_size != n) {
-        A_padded = allocateMatrix(new_size);
-        B_padded = allocateMatrix(new_size);
-        if (!A_padded || !B_padded) {
-            fprintf(stderr, "Error asignando matrices para padding.\n");
-            freeMatrix(new_size, A_padded); freeMatrix(new_size, B_padded);
-            return NULL;
+// C = A * B usando una arena ya reservada (sin malloc durante la multiplicación).
+// ws debe tener al menos strassen_workspace_size(original_size) bytes libres.
+int strassen_multiply_ws(int original_size, int **A_orig, int **B_orig, int **C, Workspace *ws) {
+    if (original_size == 0) return 0;
+    if (A_orig == NULL || B_orig == NULL || C == NULL || original_size < 0) return -1;
+
+    int n = original_size;
+    int new_size = nextPowerOfTwo(n);
+    if (new_size == n) {
+        return strassen_multiply_internal(n, A_orig, B_orig, C, ws);
+    }
+
+    size_t mark = ws->used;
+    int **A_padded = workspaceMatrix(ws, new_size);
+    int **B_padded = workspaceMatrix(ws, new_size);
+    int **C_padded = workspaceMatrix(ws, new_size);
+    if (!A_padded || !B_padded || !C_padded) {
+        fprintf(stderr, "Error asignando matrices para padding.\n");
+        ws->used = mark;
+        return -1;
+    }
+    for (int i = 0; i < new_size; i++) {
+        for (int j = 0; j < new_size; j++) {
+            if (i < n && j < n) {
+                A_padded[i][j] = A_orig[i][j];
+                B_padded[i][j] = B_orig[i][j];
+            } else {
+                A_padded[i][j] = 0; B_padded[i][j] = 0;
+            }
         }
-        for (int i = 0; i < new_size; i++) {
-            for (int j = 0; j < new_size; j++) {
-                if (i < n && j < n) {
-                    A_padded[i][j] = A_orig[i][j];
-                    B_padded[i][j] = B_orig[i][j];
-                } else {
-                    A_padded[i][j] = 0; B_padded[i][j] = 0;
-                }
+    }
+
+    int status = strassen_multiply_internal(new_size, A_padded, B_padded, C_padded, ws);
+    if (status == 0) {
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                C[i][j] = C_padded[i][j];
             }
         }
     }
+    ws->used = mark;
+    return status;
+}
+
+int **strassen_multiply(int original_size, int **A_orig, int **B_orig) {
+    if (original_size == 0) return allocateMatrix(0);
+    if (A_orig == NULL || B_orig == NULL || original_size < 0) return NULL;
 
-    int **C_padded = strassen_multiply_internal(new_size, A_padded, B_padded);
+    Workspace ws;
+    if (workspaceInit(&ws, strassen_workspace_size(original_size)) != 0) return NULL;
 
-    if (new_size != n) { // Si se hizo padding, liberar las matrices padded A y B
-        freeMatrix(new_size, A_padded); // Solo si fueron creadas (new_size != n)
-        freeMatrix(new_size, B_padded);
+    int **C_result = allocateMatrix(original_size);
+    if (!C_result) {
+        fprintf(stderr, "Error asignando matriz resultado.\n");
+        workspaceFree(&ws);
+        return NULL;
     }
-    // No liberar A_orig ni B_orig aquí, se hace en main
 
-    if (!C_padded) return NULL;
+    if (strassen_multiply_ws(original_size, A_orig, B_orig, C_result, &ws) != 0) {
+        freeMatrix(original_size, C_result);
+        C_result = NULL;
+    }
+    workspaceFree(&ws);
+    return C_result;
+}
 
-    if (new_size != n) {
-        int **C_result = allocateMatrix(n);
-        if (!C_result) {
-            fprintf(stderr, "Error asignando matriz resultado final post-padding.\n");
-            freeMatrix(new_size, C_padded); return NULL;
-        }
-        for (int i = 0; i < n; i++) {
-            for (int j = 0; j < n; j++) {
-                C_result[i][j] = C_padded[i][j];
+// --- Autotuning del umbral ---
+// Archivo de tuning compartido con la versión C++: líneas "clave=valor".
+// La versión C usa su propia clave porque su caso base es distinto.
+#define TUNING_KEY "strassen_threshold_c"
+#define TUNING_MAX_LINES 256
+#define TUNING_LINE_LEN 256
+
+const char *tuningFilePath(void) {
+    const char *path = getenv("MATMUL_TUNING_FILE");
+    return path != NULL ? path : "matmul_tuning.txt";
+}
+
+void loadTuning(void) {
+    const char *env = getenv("STRASSEN_THRESHOLD");
+    if (env != NULL) {
+        strassen_threshold = atoi(env);
+    } else {
+        FILE *f = fopen(tuningFilePath(), "r");
+        if (f != NULL) {
+            char line[TUNING_LINE_LEN];
+            size_t keyLen = strlen(TUNING_KEY);
+            while (fgets(line, sizeof(line), f) != NULL) {
+                if (strncmp(line, TUNING_KEY, keyLen) == 0 && line[keyLen] == '=') {
+                    strassen_threshold = atoi(line + keyLen + 1);
+                }
             }
+            fclose(f);
         }
-        freeMatrix(new_size, C_padded);
-        return C_result;
-    } else {
-        return C_padded;
     }
+    if (strassen_threshold < 1) strassen_threshold = 1;
 }
 
-unsigned long long strassen_extra_memory(int size) {
-    if (size <= STRASSEN_THRESHOLD) {
-        return 0; // No hay recursión, memoria extra = 0
+// Reescribe el archivo conservando las demás claves y actualizando la nuestra
+int saveTuning(int threshold) {
+    static char lines[TUNING_MAX_LINES][TUNING_LINE_LEN];
+    int count = 0;
+    size_t keyLen = strlen(TUNING_KEY);
+    FILE *f = fopen(tuningFilePath(), "r");
+    if (f != NULL) {
+        while (count < TUNING_MAX_LINES && fgets(lines[count], TUNING_LINE_LEN, f) != NULL) {
+            if (strncmp(lines[count], TUNING_KEY, keyLen) == 0 && lines[count][keyLen] == '=') continue;
+            count++;
+        }
+        fclose(f);
+    }
+    f = fopen(tuningFilePath(), "w");
+    if (f == NULL) {
+        perror("saveTuning: No se pudo escribir el archivo de tuning");
+        return -1;
     }
+    for (int i = 0; i < count; i++) fputs(lines[i], f);
+    fprintf(f, "%s=%d\n", TUNING_KEY, threshold);
+    fclose(f);
+    return 0;
+}
 
-    int newSize = size / 2;
-    // Memoria por llamada recursiva (submatrices + temporales)
-    unsigned long long mem_per_call = 10 * (newSize * newSize * sizeof(int)); // Aproximación conservadora
-    
-    // Memoria de las llamadas recursivas (7 multiplicaciones)
-    return mem_per_call + 7 * strassen_extra_memory(newSize);
+double wallTime(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Compara el caso base contra UN nivel de Strassen (hijos N/2 con el caso base)
+// para N crecientes hasta maxSize. El umbral es el mayor N en el que el caso
+// base aún gana antes de que Strassen gane en todos los tamaños siguientes.
+int autotuneThreshold(int maxSize) {
+    // Solo potencias de 2: esta versión rellena hasta la siguiente potencia
+    int candidates[] = {16, 32, 64, 128, 256, 512, 1024, 2048};
+    int numCandidates = sizeof(candidates) / sizeof(candidates[0]);
+    int sizes[sizeof(candidates) / sizeof(candidates[0])];
+    int wins[sizeof(candidates) / sizeof(candidates[0])];
+    int numSizes = 0;
+    int savedThreshold = strassen_threshold;
+
+    printf("Caso base vs un nivel de Strassen:\n  N\tbase (s)\tStrassen (s)\n");
+    for (int c = 0; c < numCandidates && candidates[c] <= maxSize; c++) {
+        int n = candidates[c];
+        int **A = allocateMatrix(n), **B = allocateMatrix(n), **C = allocateMatrix(n);
+        Workspace ws;
+        strassen_threshold = n - 1; // Un solo nivel de recursión
+        if (!A || !B || !C || workspaceInit(&ws, strassen_workspace_size(n)) != 0) {
+            freeMatrix(n, A); freeMatrix(n, B); freeMatrix(n, C);
+            break;
+        }
+        fillRandomMatrix(n, A);
+        fillRandomMatrix(n, B);
+
+        int reps = n <= 256 ? 10 : 3;
+        double baseBest = 1e30, levelBest = 1e30;
+        for (int r = 0; r <= reps; r++) { // La primera vuelta es de calentamiento
+            double start = wallTime();
+            naive_multiply_strassen_base(n, A, B, C);
+            double t = wallTime() - start;
+            if (r > 0 && t < baseBest) baseBest = t;
+
+            start = wallTime();
+            strassen_multiply_ws(n, A, B, C, &ws);
+            t = wallTime() - start;
+            if (r > 0 && t < levelBest) levelBest = t;
+        }
+        printf("  %d\t%.6f\t%.6f\n", n, baseBest, levelBest);
+        sizes[numSizes] = n;
+        wins[numSizes] = levelBest < baseBest;
+        numSizes++;
+
+        workspaceFree(&ws);
+        freeMatrix(n, A); freeMatrix(n, B); freeMatrix(n, C);
+    }
+    strassen_threshold = savedThreshold;
+
+    if (numSizes == 0) return savedThreshold;
+    int first = numSizes;
+    while (first > 0 && wins[first - 1]) first--;
+    if (first == numSizes) return sizes[numSizes - 1]; // Nunca gana en lo medido
+    if (first == 0) return sizes[0] / 2;
+    return sizes[first - 1];
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+    loadTuning();
+
+    // Opción --autotune [N]: mide el umbral hasta N (por defecto 1024) y lo guarda
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--autotune") == 0) {
+            int maxSize = (i + 1 < argc) ? atoi(argv[i + 1]) : 0;
+            int threshold = autotuneThreshold(maxSize > 0 ? maxSize : 1024);
+            printf("Umbral elegido: %s=%d\n", TUNING_KEY, threshold);
+            if (saveTuning(threshold) == 0) printf("Guardado en %s\n", tuningFilePath());
+            return 0;
+        }
+    }
+
     int size;
     clock_t startTime, endTime;
     double cpu_time_used;
@@ -352,7 +509,7 @@ int main() {
         size_t size_of_pointers_per_matrix = (size_t)size * sizeof(int *);
         size_t size_of_data_per_matrix = (size_t)size * (size_t)size * sizeof(int);
         memory_used_bytes = 3 * (size_of_pointers_per_matrix + size_of_data_per_matrix);
-        unsigned long long extra_memory = strassen_extra_memory(size);
+        unsigned long long extra_memory = strassen_workspace_size(size); // Arena de temporales (exacta)
         memory_used_bytes += extra_memory;
     }
 
@@ -364,6 +521,7 @@ int main() {
     }
 
     printf("--- Métricas de Rendimiento (Algoritmo de Strassen) ---\n");
+    printf("Umbral de Strassen: %d\n", strassen_threshold);
     printf("Tiempo de CPU para la multiplicación: %.6f segundos\n", cpu_time_used);
     printf("Memoria estimada utilizada por las matrices A, B y C (principales): %llu bytes (%.2f KB / %.2f MB)\n",
            memory_used_bytes,